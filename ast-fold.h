@@ -0,0 +1,318 @@
+#ifndef _MENCI_AST_FOLD_H
+#define _MENCI_AST_FOLD_H
+
+#include <string>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <cmath>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+
+#include <fmt/format.h>
+
+#include "ast.h"
+
+namespace AST {
+
+// Folds constant subexpressions and propagates the values of declared numeric constants into their uses.
+// Anything that would fail or trap at run time (or report a type error in codegen) is left untouched.
+class ConstantFolder {
+public:
+    struct Value {
+        bool isDouble;
+        int64_t integer;
+        double real;
+
+        static Value fromInteger(int64_t x) { return {false, x, 0}; }
+        static Value fromDouble(double x) { return {true, 0, x}; }
+
+        double toDouble() const { return isDouble ? real : (double)integer; }
+
+        // Same as cvttsd2si, but refuse the values it can't represent
+        std::optional<int64_t> toInteger() const {
+            if (!isDouble) return integer;
+            if (!(real >= -0x1p63 && real < 0x1p63)) return std::nullopt;
+            return (int64_t)real;
+        }
+    };
+
+    static std::optional<Value> parseLiteral(const std::string &literal) {
+        if (literal.empty() || literal[0] == '\'') return std::nullopt;
+
+        const char *begin = literal.c_str();
+        char *end;
+        errno = 0;
+        if (literal.find_first_of(".eE") == std::string::npos) {
+            long long x = std::strtoll(begin, &end, 10);
+            if (*end || end == begin || errno) return std::nullopt;
+            return Value::fromInteger(x);
+        } else {
+            double x = std::strtod(begin, &end);
+            if (*end || end == begin || errno || !std::isfinite(x)) return std::nullopt;
+            return Value::fromDouble(x);
+        }
+    }
+
+    static std::string formatLiteral(const Value &value) {
+        if (!value.isDouble) return std::to_string(value.integer);
+
+        // Shortest representation which reads back to the same double, and is still recognized as a double
+        auto s = fmt::format("{}", value.real);
+        if (s.find_first_of(".e") == std::string::npos) s += ".0";
+        return s;
+    }
+
+    static int64_t wrap(uint64_t x) { return (int64_t)x; }
+
+    static std::optional<Value> evaluate(BinaryOperator op, const Value &l, const Value &r) {
+        std::optional<Value> result;
+        switch (op) {
+            case BinaryOperator::Equal:
+            case BinaryOperator::NotEqual:
+            case BinaryOperator::LessThan:
+            case BinaryOperator::GreaterThan:
+            case BinaryOperator::LessThanOrEqual:
+            case BinaryOperator::GreaterThanOrEqual:
+            case BinaryOperator::Plus:
+            case BinaryOperator::Minus:
+            case BinaryOperator::Times:
+            case BinaryOperator::Slash:
+                // int op double = double, and Slash always divides in double
+                if (l.isDouble || r.isDouble || op == BinaryOperator::Slash) {
+                    double a = l.toDouble(), b = r.toDouble();
+                    switch (op) {
+                        case BinaryOperator::Equal: result = Value::fromInteger(a == b); break;
+                        case BinaryOperator::NotEqual: result = Value::fromInteger(a != b); break;
+                        case BinaryOperator::LessThan: result = Value::fromInteger(a < b); break;
+                        case BinaryOperator::GreaterThan: result = Value::fromInteger(a > b); break;
+                        case BinaryOperator::LessThanOrEqual: result = Value::fromInteger(a <= b); break;
+                        case BinaryOperator::GreaterThanOrEqual: result = Value::fromInteger(a >= b); break;
+                        case BinaryOperator::Plus: result = Value::fromDouble(a + b); break;
+                        case BinaryOperator::Minus: result = Value::fromDouble(a - b); break;
+                        case BinaryOperator::Times: result = Value::fromDouble(a * b); break;
+                        default: result = Value::fromDouble(a / b);
+                    }
+                } else {
+                    // Wrap around on overflow like the machine does
+                    int64_t a = l.integer, b = r.integer;
+                    switch (op) {
+                        case BinaryOperator::Equal: result = Value::fromInteger(a == b); break;
+                        case BinaryOperator::NotEqual: result = Value::fromInteger(a != b); break;
+                        case BinaryOperator::LessThan: result = Value::fromInteger(a < b); break;
+                        case BinaryOperator::GreaterThan: result = Value::fromInteger(a > b); break;
+                        case BinaryOperator::LessThanOrEqual: result = Value::fromInteger(a <= b); break;
+                        case BinaryOperator::GreaterThanOrEqual: result = Value::fromInteger(a >= b); break;
+                        case BinaryOperator::Plus: result = Value::fromInteger(wrap((uint64_t)a + (uint64_t)b)); break;
+                        case BinaryOperator::Minus: result = Value::fromInteger(wrap((uint64_t)a - (uint64_t)b)); break;
+                        default: result = Value::fromInteger(wrap((uint64_t)a * (uint64_t)b));
+                    }
+                }
+                break;
+            case BinaryOperator::Div:
+            case BinaryOperator::Mod:
+            case BinaryOperator::Or:
+            case BinaryOperator::Xor:
+            case BinaryOperator::And:
+            case BinaryOperator::LeftShift:
+            case BinaryOperator::RightShift: {
+                // int op int = int
+                auto a = l.toInteger(), b = r.toInteger();
+                if (!a || !b) return std::nullopt;
+                switch (op) {
+                    case BinaryOperator::Div:
+                    case BinaryOperator::Mod:
+                        // Keep the division fault for run time
+                        if (*b == 0 || (*a == INT64_MIN && *b == -1)) return std::nullopt;
+                        result = Value::fromInteger(op == BinaryOperator::Div ? *a / *b : *a % *b);
+                        break;
+                    case BinaryOperator::Or: result = Value::fromInteger(*a | *b); break;
+                    case BinaryOperator::Xor: result = Value::fromInteger(*a ^ *b); break;
+                    case BinaryOperator::And: result = Value::fromInteger(*a & *b); break;
+                    // shl / shr only use the low 6 bits of the count, and shr is a logical shift
+                    case BinaryOperator::LeftShift: result = Value::fromInteger(wrap((uint64_t)*a << (*b & 63))); break;
+                    default: result = Value::fromInteger(wrap((uint64_t)*a >> (*b & 63)));
+                }
+                break;
+            }
+            case BinaryOperator::AndThen:
+            case BinaryOperator::OrElse:
+                // Conditions are integers
+                if (l.isDouble || r.isDouble) return std::nullopt;
+                if (op == BinaryOperator::AndThen) result = Value::fromInteger(l.integer != 0 && r.integer != 0);
+                else result = Value::fromInteger(l.integer != 0 || r.integer != 0);
+                break;
+        }
+
+        if (result && result->isDouble && !std::isfinite(result->real)) return std::nullopt;
+        return result;
+    }
+
+    static std::optional<Value> evaluate(UnaryOperator op, const Value &x) {
+        switch (op) {
+            case UnaryOperator::Not:
+                if (x.isDouble) return std::nullopt;
+                return Value::fromInteger(x.integer == 0);
+            case UnaryOperator::Plus:
+                return x;
+            case UnaryOperator::Minus:
+                // The codegen computes 0 - x for doubles, so -(0.0) is +0.0
+                if (x.isDouble) return Value::fromDouble(0.0 - x.real);
+                return Value::fromInteger(wrap(-(uint64_t)x.integer));
+            default:
+                return std::nullopt;
+        }
+    }
+
+private:
+    // The declared constants of each enclosing block, innermost last
+    // A name mapped to nullopt is shadowed by a variable, parameter or callable
+    std::list<std::map<std::string, std::optional<std::string>>> scopes;
+
+    std::optional<std::string> lookup(const std::string &name) const {
+        for (auto it = scopes.rbegin(); it != scopes.rend(); it++) {
+            if (auto jt = it->find(name); jt != it->end()) return jt->second;
+        }
+        return std::nullopt;
+    }
+
+    // Resolve a constant value which may name another constant, and normalize integer literals
+    std::string resolveConstantValue(const std::string &value) const {
+        if (auto x = parseLiteral(value)) return x->isDouble ? value : formatLiteral(*x);
+        if (!value.empty() && value[0] != '\'') {
+            if (auto resolved = lookup(value)) return *resolved;
+        }
+        return value;
+    }
+
+    static std::optional<Value> getConstantValue(std::shared_ptr<Expression> expr) {
+        if (auto ex = std::dynamic_pointer_cast<ConstantExpression>(expr)) return parseLiteral(ex->value);
+        return std::nullopt;
+    }
+
+    void foldType(std::shared_ptr<Type> type) {
+        if (auto t = std::dynamic_pointer_cast<RecordType>(type)) {
+            for (auto variable : t->variables) foldType(variable->type);
+        } else if (auto t = std::dynamic_pointer_cast<ArraySchema>(type)) {
+            for (auto bound : t->bounds) {
+                bound->min = resolveConstantValue(bound->min);
+                bound->max = resolveConstantValue(bound->max);
+            }
+        } else if (auto t = std::dynamic_pointer_cast<PointerType>(type)) {
+            foldType(t->baseType);
+        }
+    }
+
+    // Only fold the subexpressions since the expression itself must stay a left value
+    void foldLeftValue(std::shared_ptr<MaybeLeftValueExpression> expr) {
+        if (auto ex = std::dynamic_pointer_cast<RecordAccessExpression>(expr)) {
+            foldLeftValue(ex->record);
+        } else if (auto ex = std::dynamic_pointer_cast<ArrayAccessExpression>(expr)) {
+            foldLeftValue(ex->array);
+            for (auto &index : ex->indexes) index = foldExpression(index);
+        } else if (auto ex = std::dynamic_pointer_cast<PointerAccessExpression>(expr)) {
+            ex->pointer = foldExpression(ex->pointer);
+        }
+    }
+
+    std::shared_ptr<Expression> foldExpression(std::shared_ptr<Expression> expr) {
+        if (auto ex = std::dynamic_pointer_cast<IdentifierExpression>(expr)) {
+            // String constants keep their single copy in the data section
+            if (auto value = lookup(ex->identifier); value && parseLiteral(*value))
+                return std::make_shared<ConstantExpression>(*value);
+        } else if (auto ex = std::dynamic_pointer_cast<MaybeLeftValueExpression>(expr)) {
+            foldLeftValue(ex);
+        } else if (auto ex = std::dynamic_pointer_cast<ConstantExpression>(expr)) {
+            ex->value = resolveConstantValue(ex->value);
+        } else if (auto ex = std::dynamic_pointer_cast<BinaryOperatorExpression>(expr)) {
+            ex->leftOperand = foldExpression(ex->leftOperand);
+            ex->rightOperand = foldExpression(ex->rightOperand);
+            auto l = getConstantValue(ex->leftOperand), r = getConstantValue(ex->rightOperand);
+            if (l && r) {
+                if (auto result = evaluate(ex->op, *l, *r))
+                    return std::make_shared<ConstantExpression>(formatLiteral(*result));
+            }
+        } else if (auto ex = std::dynamic_pointer_cast<UnaryOperatorExpression>(expr)) {
+            if (ex->op == UnaryOperator::At) {
+                if (auto operand = std::dynamic_pointer_cast<MaybeLeftValueExpression>(ex->operand))
+                    foldLeftValue(operand);
+                return expr;
+            }
+            ex->operand = foldExpression(ex->operand);
+            if (auto x = getConstantValue(ex->operand)) {
+                if (auto result = evaluate(ex->op, *x))
+                    return std::make_shared<ConstantExpression>(formatLiteral(*result));
+            }
+        } else if (auto ex = std::dynamic_pointer_cast<CallExpressionWithArguments>(expr)) {
+            // A bare identifier may be bound to a reference parameter, leave it to the codegen to check
+            for (auto &argument : ex->argumentList) {
+                if (!std::dynamic_pointer_cast<IdentifierExpression>(argument)) argument = foldExpression(argument);
+            }
+        }
+        return expr;
+    }
+
+    void foldStatement(std::shared_ptr<Statement> stmt) {
+        if (auto st = std::dynamic_pointer_cast<AssignmentStatement>(stmt)) {
+            foldLeftValue(st->left);
+            st->right = foldExpression(st->right);
+        } else if (auto st = std::dynamic_pointer_cast<CompoundStatement>(stmt)) {
+            for (auto s : st->statements) foldStatement(s);
+        } else if (auto st = std::dynamic_pointer_cast<WhileStatement>(stmt)) {
+            st->condition = foldExpression(st->condition);
+            foldStatement(st->statement);
+        } else if (auto st = std::dynamic_pointer_cast<RepeatStatement>(stmt)) {
+            st->condition = foldExpression(st->condition);
+            foldStatement(st->statement);
+        } else if (auto st = std::dynamic_pointer_cast<ForStatement>(stmt)) {
+            st->initialValue = foldExpression(st->initialValue);
+            st->finalValue = foldExpression(st->finalValue);
+            foldStatement(st->statement);
+        } else if (auto st = std::dynamic_pointer_cast<IfStatement>(stmt)) {
+            st->condition = foldExpression(st->condition);
+            foldStatement(st->statementForTrue);
+            if (st->statementForFalse) foldStatement(st->statementForFalse);
+        } else if (auto st = std::dynamic_pointer_cast<ExpressionStatement>(stmt)) {
+            st->expression = foldExpression(st->expression);
+        }
+    }
+
+    void foldBlock(std::shared_ptr<Block> block, std::shared_ptr<Callable> callable) {
+        auto &scope = scopes.emplace_back();
+
+        // Variables, parameters and callables take precedence over constants in the codegen's symbol table
+        for (auto variable : block->variables) scope[variable->name] = std::nullopt;
+        if (callable) {
+            for (auto parameter : callable->parameters) scope[parameter->name] = std::nullopt;
+        }
+        for (auto nested : block->callables) scope[nested->name] = std::nullopt;
+        if (callable) scope[callable->name] = std::nullopt;
+
+        for (auto constant : block->constants) {
+            constant->value = resolveConstantValue(constant->value);
+            scope.try_emplace(constant->name, constant->value);
+        }
+
+        for (auto typeAlias : block->typeAliases) foldType(typeAlias->type);
+        for (auto variable : block->variables) foldType(variable->type);
+        if (callable) {
+            for (auto parameter : callable->parameters) foldType(parameter->type);
+        }
+
+        for (auto nested : block->callables) foldBlock(nested->block, nested);
+        if (block->statement) foldStatement(block->statement);
+
+        scopes.pop_back();
+    }
+
+public:
+    void fold(std::shared_ptr<Program> program) {
+        foldBlock(program->topLevelBlock, nullptr);
+    }
+};
+
+}
+
+#endif // _MENCI_AST_FOLD_H
@@ -59,7 +59,11 @@ enum class BinaryOperator {
     Xor,
     And,
     LeftShift,
-    RightShift
+    RightShift,
+
+    // Short-circuit, the right operand is evaluated only if the left one doesn't decide the result
+    AndThen,
+    OrElse
 };
 
 inline std::string getBinaryOperatorName(BinaryOperator op) {
@@ -98,6 +102,10 @@ inline std::string getBinaryOperatorName(BinaryOperator op) {
         return "LeftShift";
     case BinaryOperator::RightShift:
         return "RightShift";
+    case BinaryOperator::AndThen:
+        return "AndThen";
+    case BinaryOperator::OrElse:
+        return "OrElse";
     }
 }
 
@@ -1,9 +1,11 @@
 .intel_syntax noprefix
 
-.text
+# Each function is in a section of its own with its data, so linking with --gc-sections leaves out
+# the ones a program doesn't use
 
 # Integer IO
 
+.section .text.builtin$read,"ax",@progbits
 read_fmt:
     .string "%lld"
 .globl builtin$read
@@ -12,6 +14,7 @@ builtin$read:
     mov rsi, qword ptr [rsp + 8]
     lea rax, scanf[rip]
     jmp builtin$callsysv
+.section .text.builtin$write,"ax",@progbits
 write_fmt:
     .string "%lld"
 .globl builtin$write
@@ -20,6 +23,7 @@ builtin$write:
     mov rsi, qword ptr [rsp + 8]
     lea rax, printf[rip]
     jmp builtin$callsysv
+.section .text.builtin$writeln,"ax",@progbits
 writeln_fmt:
     .string "%lld\n"
 .globl builtin$writeln
@@ -31,6 +35,7 @@ builtin$writeln:
 
 # Floating IO
 
+.section .text.builtin$readf,"ax",@progbits
 readf_fmt:
     .string "%lf"
 .globl builtin$readf
@@ -39,6 +44,7 @@ builtin$readf:
     mov rsi, qword ptr [rsp + 8]
     lea rax, scanf[rip]
     jmp builtin$callsysv
+.section .text.builtin$writef,"ax",@progbits
 writef_fmt:
     .string "%.10lf"
 .globl builtin$writef
@@ -47,6 +53,7 @@ builtin$writef:
     movsd xmm0, qword ptr [rsp + 8]
     lea rax, printf[rip]
     jmp builtin$callsysv
+.section .text.builtin$writefln,"ax",@progbits
 writefln_fmt:
     .string "%.10lf\n"
 .globl builtin$writefln
@@ -58,32 +65,33 @@ builtin$writefln:
 
 # String IO
 
+.section .text.builtin$readsln,"ax",@progbits
 readsln_fmt:
     .string "%m[^\n]"
 .globl builtin$readsln
 builtin$readsln:
     mov rdi, qword ptr [rsp + 8]
     mov rdi, qword ptr [rdi]
-    lea rax, free[rip]
-    call builtin$callsysv
+    call builtin$freestring
     lea rdi, readsln_fmt[rip]
     mov rsi, qword ptr [rsp + 8]
     lea rax, scanf[rip]
     call builtin$callsysv
     lea rax, getchar[rip] # eat '\n'
     jmp builtin$callsysv
+.section .text.builtin$reads,"ax",@progbits
 reads_fmt:
     .string "%ms"
 .globl builtin$reads
 builtin$reads:
     mov rdi, qword ptr [rsp + 8]
     mov rdi, qword ptr [rdi]
-    lea rax, free[rip]
-    call builtin$callsysv
+    call builtin$freestring
     lea rdi, reads_fmt[rip]
     mov rsi, qword ptr [rsp + 8]
     lea rax, scanf[rip]
     jmp builtin$callsysv
+.section .text.builtin$writes,"ax",@progbits
 writes_fmt:
     .string "%s"
 .globl builtin$writes
@@ -92,6 +100,7 @@ builtin$writes:
     mov rsi, qword ptr [rsp + 8]
     lea rax, printf[rip]
     jmp builtin$callsysv
+.section .text.builtin$writesln,"ax",@progbits
 writesln_fmt:
     .string "%s\n"
 .globl builtin$writesln
@@ -103,6 +112,36 @@ builtin$writesln:
 
 # String Utility
 
+# The buffer of the strings not assigned yet, shared and never written or freed
+.section .rodata.builtin$emptystring,"a",@progbits
+.globl builtin$emptystring
+builtin$emptystring:
+    .byte 0
+
+# Free the buffer in rdi unless it's the shared empty one
+.section .text.builtin$freestring,"ax",@progbits
+.globl builtin$freestring
+builtin$freestring:
+    lea rax, builtin$emptystring[rip]
+    cmp rdi, rax
+    je freestring_skip
+    lea rax, free[rip]
+    jmp builtin$callsysv
+freestring_skip:
+    ret
+# Resize the buffer in rdi to rsi bytes, allocating it if it's the shared empty one
+.section .text.builtin$resizestring,"ax",@progbits
+.globl builtin$resizestring
+builtin$resizestring:
+    lea rax, builtin$emptystring[rip]
+    cmp rdi, rax
+    jne resizestring_realloc
+    xor rdi, rdi
+resizestring_realloc:
+    lea rax, realloc[rip]
+    jmp builtin$callsysv
+
+.section .text.builtin$strlen,"ax",@progbits
 .globl builtin$strlen
 builtin$strlen:
     mov rdi, qword ptr [rsp + 8]
@@ -110,6 +149,7 @@ builtin$strlen:
     call builtin$callsysv
     mov r15, rax
     ret
+.section .text.builtin$strcat,"ax",@progbits
 strcat_fmt:
     .string "%s%s"
 .globl builtin$strcat
@@ -123,17 +163,18 @@ builtin$strcat:
     call builtin$callsysv
     mov rdi, qword ptr [rsp + 16] # arg 3
     mov rdi, qword ptr [rdi]
-    lea rax, free[rip]
-    call builtin$callsysv
+    call builtin$freestring
     mov rdi, qword ptr [rsp + 16] # arg 3
     pop qword ptr [rdi]
     ret
+.section .text.builtin$getchr,"ax",@progbits
 .globl builtin$getchr
 builtin$getchr:
     mov rdi, qword ptr [rsp + 16]
     mov rsi, qword ptr [rsp + 8]
     movzx r15, byte ptr [rdi + rsi]
     ret
+.section .text.builtin$setchr,"ax",@progbits
 .globl builtin$setchr
 builtin$setchr:
     mov rdi, qword ptr [rsp + 24]
@@ -142,8 +183,17 @@ builtin$setchr:
     mov byte ptr [rdi + rsi], al
     ret
 
+.section .text.builtin$callsysv,"ax",@progbits
 .globl builtin$callsysv
 builtin$callsysv:
+    # Preserve the registers callee-saved in our calling convention but not in System V's
+    push r10
+    push r11
+    sub rsp, 32
+    movsd qword ptr [rsp], xmm12
+    movsd qword ptr [rsp + 8], xmm13
+    movsd qword ptr [rsp + 16], xmm14
+    movsd qword ptr [rsp + 24], xmm15
     # Make stack 16-bit aligned
     push rsp
     push qword ptr [rsp]
@@ -151,8 +201,16 @@ builtin$callsysv:
     call rax
     # Restore stack
     mov rsp, qword ptr [rsp + 8]
+    movsd xmm12, qword ptr [rsp]
+    movsd xmm13, qword ptr [rsp + 8]
+    movsd xmm14, qword ptr [rsp + 16]
+    movsd xmm15, qword ptr [rsp + 24]
+    add rsp, 32
+    pop r11
+    pop r10
     ret
 
+.section .text.builtin$checkarrayindex,"ax",@progbits
 checkarrayindex_fmt:
     .string "Runtime Error: Invalid index %lld for the %lld-th dimension, valid range is [%lld, %lld]\n"
 .globl builtin$checkarrayindex
@@ -2,6 +2,12 @@
 #define _MENCI_CODEGEN_H
 
 #include <map>
+#include <set>
+#include <optional>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -9,12 +15,73 @@
 #include <fmt/format.h>
 
 #include "ast.h"
+#include "ir.h"
+#include "peephole.h"
 
 namespace CodeGen {
 
+// How nested functions reach the frames of their enclosing functions
+enum class NonLocalAccess {
+    StaticLink, // The caller passes the frame of the callee's parent, which links to its own parent
+    Display     // Every activation publishes its frame in a global table indexed by level
+};
+
+// The extensions of x86-64 the vector loops may use
+enum class InstructionSet {
+    SSE2, // Two 64-bit lanes in the XMM registers, which every x86-64 processor has
+    AVX2  // Four lanes in the YMM registers
+};
+
+struct Options {
+    bool peephole = true;
+    bool peepholeStatistics = false;
+    bool dumpIR = false;
+    bool constantPropagation = true;
+    NonLocalAccess nonLocalAccess = NonLocalAccess::StaticLink;
+    bool boundsCheck = true;
+    bool inlining = true;
+    bool inliningReport = false;
+    bool tailCalls = true;
+    bool inductionPointers = true;
+    bool loopInvariantMotion = true;
+    bool commonSubexpressions = true;
+    bool commonSubexpressionsReport = false;
+    bool shortCircuit = true;
+    bool strengthReduction = true;
+    bool vectorization = true;
+    InstructionSet instructionSet = InstructionSet::SSE2;
+    bool deadFunctionElimination = true;
+    bool registerArguments = true;
+    bool frameOmission = true;
+} options;
+
+// rax, rcx and rdx are scratch registers, which are never live across labels, jumps or calls to non-builtin functions
 const char *REG_FRAME_BASE = "rbx";
 const char *REG_RETURN_VALUE = "r15";
 const char *REG_LEFT_VALUE_POINTER = "r14";
+const std::vector<std::string> REG_TEMPORARIES = {"rsi", "rdi", "r8", "r9"};
+const std::vector<std::string> REG_DOUBLE_TEMPORARIES = {
+    "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7", "xmm8", "xmm9", "xmm10", "xmm11"
+};
+// Callee-saved in our calling convention, builtin$callsysv preserves the ones System V doesn't
+const std::vector<std::string> REG_VARIABLES = {"r12", "r13", "r10", "r11"};
+const std::vector<std::string> REG_DOUBLE_VARIABLES = {"xmm12", "xmm13", "xmm14", "xmm15"};
+
+bool isDoubleRegister(const std::string &reg) {
+    return reg.compare(0, 3, "xmm") == 0;
+}
+
+// "mov" for general-purpose registers, "movsd" for XMM registers
+const char *getMoveInstruction(const std::string &reg) {
+    return isDoubleRegister(reg) ? "movsd" : "mov";
+}
+
+// The qword at a constant displacement from a base register
+std::string getMemoryOperand(const std::string &base, ssize_t displacement) {
+    if (displacement == 0) return fmt::format("qword ptr [{}]", base);
+    if (displacement > 0) return fmt::format("qword ptr [{} + {}]", base, displacement);
+    return fmt::format("qword ptr [{} - {}]", base, -displacement);
+}
 
 template <typename ...Args>
 void __attribute__((noreturn)) reportError(const std::string &format, Args &&...args) {
@@ -47,6 +114,11 @@ public:
         return label;
     }
 
+    // Labels referenced from outside of this context must be given as entries
+    void optimize(PeepholeOptimizer &optimizer, const std::set<std::string> &entryLabels) {
+        optimizer.run(lines, entryLabels);
+    }
+
     std::string getCode() const {
         std::string result;
         for (auto line : lines) result += line + "\n";
@@ -54,14 +126,147 @@ public:
     }
 };
 
+void generateMove(AssemblyContext &ctx, const std::string &to, const std::string &from) {
+    if (to == from) return;
+    if (isDoubleRegister(to) && isDoubleRegister(from))
+        ctx.generate("movapd {}, {}", to, from);
+    else if (isDoubleRegister(to) || isDoubleRegister(from))
+        ctx.generate("movq {}, {}", to, from);
+    else
+        ctx.generate("mov {}, {}", to, from);
+}
+
+// Allocates registers for expression temporaries in stack order. Under register pressure the
+// bottom-most temporaries are spilled to the machine stack, so the spilled ones always form a
+// prefix that mirrors the machine stack. All temporaries must be spilled before a call.
+class TemporaryAllocator {
+    struct Temporary {
+        bool isDouble;
+        std::string reg; // Empty if spilled
+    };
+
+    std::vector<Temporary> temporaries;
+    size_t spilledCount = 0;
+
+    std::string allocateRegister(bool isDouble) const {
+        for (auto &reg : isDouble ? REG_DOUBLE_TEMPORARIES : REG_TEMPORARIES) {
+            bool used = false;
+            for (size_t i = spilledCount; i < temporaries.size(); i++)
+                if (temporaries[i].reg == reg) used = true;
+            if (!used) return reg;
+        }
+        return "";
+    }
+
+    void spillOne(AssemblyContext &ctx) {
+        auto &temporary = temporaries[spilledCount++];
+        pushRegister(ctx, temporary.reg);
+        temporary.reg.clear();
+    }
+
+    void reloadOne(AssemblyContext &ctx) {
+        auto &temporary = temporaries[--spilledCount];
+        temporary.reg = allocateRegister(temporary.isDouble);
+        if (temporary.isDouble) {
+            ctx.generate("movsd {}, qword ptr [rsp]", temporary.reg);
+            ctx.generate("add rsp, 8");
+        } else
+            ctx.generate("pop {}", temporary.reg);
+    }
+
+public:
+    static void pushRegister(AssemblyContext &ctx, const std::string &reg) {
+        if (isDoubleRegister(reg)) {
+            ctx.generate("sub rsp, 8");
+            ctx.generate("movsd qword ptr [rsp], {}", reg);
+        } else
+            ctx.generate("push {}", reg);
+    }
+
+    // Push a new temporary and return the register to put its value in
+    std::string push(AssemblyContext &ctx, bool isDouble) {
+        std::string reg;
+        while ((reg = allocateRegister(isDouble)).empty()) spillOne(ctx);
+        temporaries.push_back({isDouble, reg});
+        return reg;
+    }
+
+    // Return the register of the depth-th temporary from the top, reloading it if spilled
+    std::string get(AssemblyContext &ctx, size_t depth = 0) {
+        size_t index = temporaries.size() - 1 - depth;
+        while (spilledCount > index) reloadOne(ctx);
+        return temporaries[index].reg;
+    }
+
+    // Push a copy of the depth-th temporary from the top, which is read where it is even if spilled,
+    // as reloading it may take more registers than there are
+    std::string pushCopy(AssemblyContext &ctx, size_t depth) {
+        size_t index = temporaries.size() - 1 - depth;
+        bool isDouble = temporaries[index].isDouble;
+        auto reg = push(ctx, isDouble);
+        if (index < spilledCount)
+            ctx.generate("{} {}, qword ptr [rsp + {}]", isDouble ? "movsd" : "mov", reg, (spilledCount - 1 - index) * 8);
+        else
+            generateMove(ctx, reg, temporaries[index].reg);
+        return reg;
+    }
+
+    void pop(AssemblyContext &ctx) {
+        if (spilledCount == temporaries.size()) {
+            ctx.generate("add rsp, 8");
+            spilledCount--;
+        }
+        temporaries.pop_back();
+    }
+
+    // Move the depth-th temporary to a register of another class, returns [old register, new register]
+    std::pair<std::string, std::string> convert(AssemblyContext &ctx, size_t depth, bool isDouble) {
+        auto from = get(ctx, depth);
+        std::string to;
+        while ((to = allocateRegister(isDouble)).empty()) spillOne(ctx);
+        temporaries[temporaries.size() - 1 - depth] = {isDouble, to};
+        return {from, to};
+    }
+
+    void spill(AssemblyContext &ctx) {
+        while (spilledCount < temporaries.size()) spillOne(ctx);
+    }
+
+    size_t size() const { return temporaries.size(); }
+
+    // Remove the count temporaries right below the top one
+    void popBelowTop(AssemblyContext &ctx, size_t count) {
+        get(ctx); // The spilled ones left are below the removed ones on the machine stack
+        size_t begin = temporaries.size() - 1 - count;
+        if (spilledCount > begin) {
+            ctx.generate("add rsp, {}", (spilledCount - begin) * 8);
+            spilledCount = begin;
+        }
+        temporaries.erase(temporaries.begin() + begin, temporaries.end() - 1);
+    }
+};
+
 class Type {
 public:
     virtual ~Type() = default;
 
-    virtual void onInitialize(AssemblyContext &ctx) const = 0;
-    virtual void onAssign(AssemblyContext &ctx) const = 0;
+    // Called on zero-filled storage, only for the types needing more than that
+    virtual void onInitialize(AssemblyContext &ctx) const {}
+    // The right value is in the register "value"
+    virtual void onAssign(AssemblyContext &ctx, const std::string &value) const = 0;
+    // The right value's address is in the register "source", and it isn't used afterwards.
+    // An aggregate's value is its address, so it's copied unless it has buffers to hand over.
+    virtual void onMove(AssemblyContext &ctx, const std::string &source) const { onAssign(ctx, source); }
+
+    // Every type takes whole qwords, so frames, .bss and records keep everything 8-byte aligned
+    virtual size_t getSize() const { return 8; }
+    // A single qword, zero initially and copied as is
+    virtual bool isPlain() const { return false; }
+    // Stored inline in frames and in the enclosing aggregates, its value is its address
+    virtual bool isAggregate() const { return false; }
 
     virtual bool allowedPassByValue() const { return false; }
+    virtual bool needInitialize() const { return false; }
     virtual bool needFinalize() const { return false; }
     virtual void onFinalize(AssemblyContext &ctx) const {}
 
@@ -73,14 +278,11 @@ public:
 
 class TypeInteger : public Type {
 public:
-    virtual void onInitialize(AssemblyContext &ctx) const {
-        ctx.generate("mov qword ptr [{}], 0", REG_LEFT_VALUE_POINTER);
-    }
-
-    virtual void onAssign(AssemblyContext &ctx) const {
-        ctx.generate("pop qword ptr [{}]", REG_LEFT_VALUE_POINTER);
+    virtual void onAssign(AssemblyContext &ctx, const std::string &value) const {
+        ctx.generate("{} qword ptr [{}], {}", getMoveInstruction(value), REG_LEFT_VALUE_POINTER, value);
     }
 
+    virtual bool isPlain() const { return true; }
     virtual bool allowedPassByValue() const { return true; }
 
     virtual std::string getSignature() const {
@@ -90,14 +292,11 @@ public:
 
 class TypeDouble : public Type {
 public:
-    virtual void onInitialize(AssemblyContext &ctx) const {
-        ctx.generate("mov qword ptr [{}], 0", REG_LEFT_VALUE_POINTER);
-    }
-
-    virtual void onAssign(AssemblyContext &ctx) const {
-        ctx.generate("pop qword ptr [{}]", REG_LEFT_VALUE_POINTER);
+    virtual void onAssign(AssemblyContext &ctx, const std::string &value) const {
+        ctx.generate("{} qword ptr [{}], {}", getMoveInstruction(value), REG_LEFT_VALUE_POINTER, value);
     }
 
+    virtual bool isPlain() const { return true; }
     virtual bool allowedPassByValue() const { return true; }
 
     virtual std::string getSignature() const {
@@ -111,14 +310,11 @@ public:
 
     TypePointer(std::shared_ptr<Type> valueType) : valueType(valueType) {}
 
-    virtual void onInitialize(AssemblyContext &ctx) const {
-        ctx.generate("mov qword ptr [{}], 0", REG_LEFT_VALUE_POINTER);
-    }
-
-    virtual void onAssign(AssemblyContext &ctx) const {
-        ctx.generate("pop qword ptr [{}]", REG_LEFT_VALUE_POINTER);
+    virtual void onAssign(AssemblyContext &ctx, const std::string &value) const {
+        ctx.generate("{} qword ptr [{}], {}", getMoveInstruction(value), REG_LEFT_VALUE_POINTER, value);
     }
 
+    virtual bool isPlain() const { return true; }
     virtual bool allowedPassByValue() const { return true; }
 
     virtual std::string getSignature() const {
@@ -128,39 +324,51 @@ public:
 
 class TypeString : public Type {
 public:
+    // A buffer is only allocated when a string is assigned, until then it shares a static empty one
     virtual void onInitialize(AssemblyContext &ctx) const {
-        ctx.generate("mov rdi, 1");
-        ctx.generate("lea rax, malloc[rip]");
-        ctx.generate("call builtin$callsysv");
-        ctx.generate("mov byte ptr [rax], 0");
+        ctx.generate("lea rax, builtin$emptystring[rip]");
         ctx.generate("mov qword ptr [{}], rax", REG_LEFT_VALUE_POINTER);
     }
 
-    virtual void onAssign(AssemblyContext &ctx) const {
-        ctx.generate("mov rdi, qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-        ctx.generate("lea rax, free[rip]");
-        ctx.generate("call builtin$callsysv");
+    // The buffer is resized with realloc, which reuses it in place when it's large enough
+    virtual void onAssign(AssemblyContext &ctx, const std::string &value) const {
+        AssemblyContext ctxEnd("StringAssignEnd");
+        ctx.generate("cmp {}, qword ptr [{}]", value, REG_LEFT_VALUE_POINTER);
+        ctx.generate("je {}", ctxEnd.getLabel());
 
-        ctx.generate("mov rdi, qword ptr [rsp]");
+        ctx.generate("push {}", value);
+        ctx.generate("mov rdi, {}", value);
         ctx.generate("lea rax, strlen[rip]");
         ctx.generate("call builtin$callsysv");
+        ctx.generate("inc rax");
+        ctx.generate("push rax");
 
-        ctx.generate("mov rdi, rax");
-        ctx.generate("lea rax, malloc[rip]");
-        ctx.generate("call builtin$callsysv");
+        ctx.generate("mov rdi, qword ptr [{}]", REG_LEFT_VALUE_POINTER);
+        ctx.generate("mov rsi, rax");
+        ctx.generate("call builtin$resizestring");
         ctx.generate("mov qword ptr [{}], rax", REG_LEFT_VALUE_POINTER);
 
         ctx.generate("mov rdi, rax");
+        ctx.generate("pop rdx");
         ctx.generate("pop rsi");
-        ctx.generate("lea rax, strcpy[rip]");
+        ctx.generate("lea rax, memcpy[rip]");
         ctx.generate("call builtin$callsysv");
+        ctx.append(std::move(ctxEnd));
+    }
+
+    // Swap the buffers, the source's new one is freed when it's finalized or assigned again
+    virtual void onMove(AssemblyContext &ctx, const std::string &source) const {
+        ctx.generate("mov rcx, qword ptr [{}]", REG_LEFT_VALUE_POINTER);
+        ctx.generate("mov rdx, qword ptr [{}]", source);
+        ctx.generate("mov qword ptr [{}], rdx", REG_LEFT_VALUE_POINTER);
+        ctx.generate("mov qword ptr [{}], rcx", source);
     }
 
+    virtual bool needInitialize() const { return true; }
     virtual bool needFinalize() const { return true; }
     virtual void onFinalize(AssemblyContext &ctx) const {
         ctx.generate("mov rdi, qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-        ctx.generate("lea rax, free[rip]");
-        ctx.generate("call builtin$callsysv");
+        ctx.generate("call builtin$freestring");
     }
 
     virtual std::string getSignature() const {
@@ -177,16 +385,80 @@ std::map<std::string, std::shared_ptr<Type>> builtinTypes = {
     {"string", builtinTypeString}
 };
 
+// Whether values of the type are held in XMM registers
+bool isDoubleType(std::shared_ptr<Type> type) {
+    return std::dynamic_pointer_cast<TypeDouble>(type) != nullptr;
+}
+
 class Symbol {
 public:
     virtual ~Symbol() = default;
 };
 
+// Double and string literals interned by value, emitted once into .rodata
+class ConstantPool {
+    struct Entry {
+        std::string label, directive;
+    };
+
+    std::map<std::string, std::string> labels;
+    std::vector<Entry> doubles, strings;
+
+    std::string intern(std::vector<Entry> &section, const std::string &key, const std::string &directive) {
+        if (auto it = labels.find(key); it != labels.end()) return it->second;
+
+        auto label = AssemblyContext("Constant").getLabel();
+        section.push_back({label, directive});
+        return labels[key] = label;
+    }
+
+public:
+    std::string internDouble(const std::string &literalValue) {
+        // Key by bit pattern so different spellings of the same value share an entry
+        double value = std::strtod(literalValue.c_str(), nullptr);
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return intern(doubles, fmt::format("d{:x}", bits), fmt::format(".double {}", literalValue));
+    }
+
+    std::string internString(const std::string &literalValue) {
+        std::string s = ".byte ";
+        for (size_t i = 1; i < literalValue.size() - 1; i++) {
+            s += std::to_string((int)literalValue[i]) + ", ";
+            if (literalValue[i] == '\'') i++;
+        }
+        s += "0";
+        return intern(strings, "s" + s, s);
+    }
+
+    // Doubles go first so they are all 8-byte aligned. Only the entries the code refers to are
+    // given, which leaves out the literals of the functions left out
+    std::string getCode(const std::string &code) const {
+        const std::string prefix = ".Constant_";
+        std::set<std::string> referenced;
+        for (auto i = code.find(prefix); i != std::string::npos; i = code.find(prefix, i + 1))
+            referenced.insert(code.substr(i, code.find_first_not_of("0123456789", i + prefix.size()) - i));
+
+        std::string result = ".section .rodata\n"
+                             ".p2align 3\n";
+        for (auto section : {&doubles, &strings}) {
+            for (auto &entry : *section)
+                if (referenced.count(entry.label)) result += entry.label + ":\n    " + entry.directive + "\n";
+        }
+        return result;
+    }
+};
+
+ConstantPool constantPool;
+
+// Facts about the program computed on the SSA form before emission
+IR::ConstantPropagation constantPropagation;
+std::map<const AST::Expression *, IR::Type> expressionTypes;
+
 class Constant : public Symbol {
 public:
     std::shared_ptr<Type> type;
     std::string literalValue;
-    std::string label;
 
     Constant(const std::string &literalValue) : literalValue(literalValue) {
         if (literalValue[0] == '\'') type = builtinTypeString;
@@ -194,32 +466,24 @@ public:
         else type = builtinTypeDouble;
     }
 
-    void generate(AssemblyContext &ctx) {
-        auto nctx = AssemblyContext("Constant");
-        if (type == builtinTypeString) {
-            std::string s = ".byte ";
-            for (size_t i = 1; i < literalValue.size() - 1; i++) {
-                s += std::to_string((int)literalValue[i]) + ", ";
-                if (literalValue[i] == '\'') i++;
-            }
-            s += "0";
-            nctx.generate(s);
-        } else if (type == builtinTypeInteger) {
-            nctx.generate(".quad {}", literalValue);
-        } else {
-            nctx.generate(".double {}", literalValue);
-        }
-        label = nctx.getLabel();
-        ctx.append(std::move(nctx));
+    // The value if it's an integer fitting in a sign-extended 32-bit immediate
+    std::optional<int32_t> getImmediate() const {
+        if (type != builtinTypeInteger) return std::nullopt;
+        errno = 0;
+        char *end;
+        long long value = std::strtoll(literalValue.c_str(), &end, 10);
+        if (*end || errno || value < INT32_MIN || value > INT32_MAX) return std::nullopt;
+        return value;
     }
 
-    void onLoadToStack(AssemblyContext &ctx) const {
+    void onLoadToRegister(AssemblyContext &ctx, const std::string &reg) const {
         if (type == builtinTypeString) {
-            ctx.generate("lea rax, {}[rip]", label);
+            ctx.generate("lea {}, {}[rip]", reg, constantPool.internString(literalValue));
+        } else if (type == builtinTypeInteger) {
+            ctx.generate("mov {}, {}", reg, literalValue);
         } else {
-            ctx.generate("mov rax, {}[rip]", label);
+            ctx.generate("{} {}, {}[rip]", getMoveInstruction(reg), reg, constantPool.internDouble(literalValue));
         }
-        ctx.generate("push rax");
     }
 };
 
@@ -228,28 +492,44 @@ public:
     std::shared_ptr<Type> type;
     ssize_t frameOffset;
     bool isReference;
+    bool isEscaping = false; // Bound to a reference, address taken or accessed from a nested block
+    std::string reg; // Non-empty if promoted to a register for its whole lifetime
+    std::string symbol; // Non-empty if allocated in static storage instead of a frame
+    bool isWritten = true; // False if it provably keeps its initial value for its whole lifetime
 
     Variable(std::shared_ptr<Type> type, ssize_t frameOffset, bool isReference = false)
     : type(type), frameOffset(frameOffset), isReference(isReference) {}
 
+    bool isPromoted() const { return !reg.empty(); }
+    bool isStatic() const { return !symbol.empty(); }
+    // The initial values own no buffers
+    bool needFinalize() const { return isWritten && type->needFinalize(); }
+
     void onLoadPointerToRegister(AssemblyContext &ctx) const {
-        ctx.generate("mov rax, {}", frameOffset);
-        ctx.generate("lea {}, qword ptr [{} + rax * 8]", REG_LEFT_VALUE_POINTER, REG_FRAME_BASE);
+        if (isPromoted()) reportError("Bug!");
+        if (isStatic()) return ctx.generate("lea {}, qword ptr {}[rip]", REG_LEFT_VALUE_POINTER, symbol);
+        ctx.generate("lea {}, {}", REG_LEFT_VALUE_POINTER, getMemoryOperand(REG_FRAME_BASE, frameOffset * 8));
     }
 
-    void onLoadToStack(AssemblyContext &ctx) const {
-        ctx.generate("mov rax, {}", frameOffset);
-        ctx.generate("mov rax, qword ptr [{} + rax * 8]", REG_FRAME_BASE);
-        ctx.generate("push rax");
+    void onLoadToRegister(AssemblyContext &ctx, const std::string &reg) const {
+        if (isPromoted()) return generateMove(ctx, reg, this->reg);
+        // The value of an aggregate is its address
+        auto op = type->isAggregate() && !isReference ? "lea" : getMoveInstruction(reg);
+        if (isStatic()) return ctx.generate("{} {}, qword ptr {}[rip]", op, reg, symbol);
+        ctx.generate("{} {}, {}", op, reg, getMemoryOperand(REG_FRAME_BASE, frameOffset * 8));
     }
 
     void onInitialize(AssemblyContext &ctx) const {
+        if (isPromoted()) {
+            ctx.generate("{} {}, {}", isDoubleRegister(reg) ? "xorpd" : "xor", reg, reg);
+            return;
+        }
         onLoadPointerToRegister(ctx);
         type->onInitialize(ctx);
     }
 
     void onFinalize(AssemblyContext &ctx) const {
-        if (!type->needFinalize()) return;
+        if (!needFinalize()) return;
         onLoadPointerToRegister(ctx);
         type->onFinalize(ctx);
     }
@@ -260,86 +540,127 @@ public:
     std::map<std::string, std::shared_ptr<Variable>> variables;
 
     void onInitialize(AssemblyContext &ctx) const {
+        // The storage is zero-filled by the loader or the function's prologue
         for (auto [name, var] : variables) {
-            ctx.generate("push {}", REG_FRAME_BASE);
-            var->onInitialize(ctx);
-            ctx.generate("pop {}", REG_FRAME_BASE);
+            if (var->isPromoted() || var->type->needInitialize()) var->onInitialize(ctx);
         }
     }
 
     void onFinalize(AssemblyContext &ctx) const {
-        for (auto [name, var] : variables) {
-            if (var->type->needFinalize()) {
-                ctx.generate("push {}", REG_FRAME_BASE);
-                var->onFinalize(ctx);
-                ctx.generate("pop {}", REG_FRAME_BASE);
-            }
-        }
+        for (auto [name, var] : variables) var->onFinalize(ctx);
     }
 
     // For record
+    bool needInitialize() const {
+        for (auto [name, var] : variables)
+            if (var->type->needInitialize()) return true;
+        return false;
+    }
+
     bool needFinalize() const {
         for (auto [name, var] : variables)
-            if (var->type->needFinalize()) return true;
+            if (var->needFinalize()) return true;
         return false;
     }
 };
 
+// Aggregates up to this many qwords are zero-filled and copied with one mov per qword
+const size_t BULK_UNROLL_LIMIT = 8;
+
+// Copy size bytes from the address in the register "value" to REG_LEFT_VALUE_POINTER, as a whole.
+// The larger copies clobber rsi and rdi, like the calls in the string assignment.
+void generateBulkCopy(AssemblyContext &ctx, const std::string &value, size_t size) {
+    if (size / 8 <= BULK_UNROLL_LIMIT) {
+        for (size_t offset = 0; offset < size; offset += 8) {
+            ctx.generate("mov rcx, {}", getMemoryOperand(value, offset));
+            ctx.generate("mov {}, rcx", getMemoryOperand(REG_LEFT_VALUE_POINTER, offset));
+        }
+        return;
+    }
+    ctx.generate("mov rsi, {}", value);
+    ctx.generate("mov rdi, {}", REG_LEFT_VALUE_POINTER);
+    ctx.generate("mov rcx, {}", size / 8);
+    ctx.generate("rep movsq");
+}
+
+// The members are laid out inline, at the frame offsets of their variables
 class TypeRecord : public Type {
     Frame frame;
-    size_t count;
+    size_t size;
+
+    // Generate code for each member with REG_LEFT_VALUE_POINTER pointing to it, the record's address is kept
+    template <typename Generator>
+    void forEachMember(AssemblyContext &ctx, bool (*filter)(const Type &), Generator generator) const {
+        for (auto [name, var] : frame.variables) {
+            if (!filter(*var->type)) continue;
+            ctx.generate("push {}", REG_LEFT_VALUE_POINTER);
+            if (var->frameOffset != 0)
+                ctx.generate("lea {}, {}", REG_LEFT_VALUE_POINTER, getMemoryOperand(REG_LEFT_VALUE_POINTER, var->frameOffset * 8));
+            generator(*var);
+            ctx.generate("pop {}", REG_LEFT_VALUE_POINTER);
+        }
+    }
+
+    // Moving hands the members' buffers over instead of copying them
+    void assignMembers(AssemblyContext &ctx, const std::string &value, bool move) const {
+        if (!needFinalize()) return generateBulkCopy(ctx, value, size);
+
+        for (auto [name, var] : frame.variables) {
+            if (!var->type->isPlain()) continue;
+            ctx.generate("mov rcx, {}", getMemoryOperand(value, var->frameOffset * 8));
+            ctx.generate("mov {}, rcx", getMemoryOperand(REG_LEFT_VALUE_POINTER, var->frameOffset * 8));
+        }
+
+        // The members with their own assignment may clobber the register "value"
+        ctx.generate("push {}", value);
+        forEachMember(ctx, [](const Type &type) { return !type.isPlain(); }, [&](const Variable &var) {
+            ctx.generate("mov rax, qword ptr [rsp + 8]"); // The right record's address
+            ctx.generate("{} rax, {}", move || var.type->isAggregate() ? "lea" : "mov", getMemoryOperand("rax", var.frameOffset * 8));
+            if (move) var.type->onMove(ctx, "rax");
+            else var.type->onAssign(ctx, "rax");
+        });
+        ctx.generate("add rsp, 8");
+    }
 
 public:
-    TypeRecord(std::map<std::string, std::shared_ptr<Variable>> variables) : count(variables.size()) {
+    TypeRecord(std::map<std::string, std::shared_ptr<Variable>> variables, size_t size) : size(size) {
         frame.variables = variables;
     }
 
-    std::shared_ptr<Variable> resolveMember(const std::string &name) const {
+    std::shared_ptr<Variable> findMember(const std::string &name) const {
         auto it = frame.variables.find(name);
-        if (it == frame.variables.end()) reportError("No such member in record: {}", name);
-        return it->second;
+        return it == frame.variables.end() ? nullptr : it->second;
     }
 
-    virtual void onInitialize(AssemblyContext &ctx) const {
-        ctx.generate("mov rdi, {}", count * 8);
-        ctx.generate("lea rax, malloc[rip]");
-        ctx.generate("call builtin$callsysv");
-        ctx.generate("mov {}, rax", REG_FRAME_BASE);
-        ctx.generate("mov qword ptr [{}], {}", REG_LEFT_VALUE_POINTER, REG_FRAME_BASE);
-        frame.onInitialize(ctx);
+    std::shared_ptr<Variable> resolveMember(const std::string &name) const {
+        auto member = findMember(name);
+        if (!member) reportError("No such member in record: {}", name);
+        return member;
     }
 
-    virtual void onAssign(AssemblyContext &ctx) const {
-        ctx.generate("mov {}, qword ptr [{}]", REG_FRAME_BASE, REG_LEFT_VALUE_POINTER); // Load the left record's frame address
-        for (auto [name, var] : frame.variables) {
-            var->onLoadPointerToRegister(ctx);
+    virtual size_t getSize() const { return size; }
+    virtual bool isAggregate() const { return true; }
 
-            ctx.generate("push {}", REG_FRAME_BASE); // Save the right record's frame address
-            ctx.generate("mov {}, qword ptr [rsp + 8]", REG_FRAME_BASE); // Load the right value record's frame address
-            
-            var->onLoadToStack(ctx);
-            var->type->onAssign(ctx);
+    virtual void onInitialize(AssemblyContext &ctx) const {
+        forEachMember(ctx, [](const Type &type) { return type.needInitialize(); }, [&](const Variable &var) {
+            var.type->onInitialize(ctx);
+        });
+    }
 
-            ctx.generate("pop {}", REG_FRAME_BASE);
-        }
-        ctx.generate("add rsp, 8");
+    virtual void onAssign(AssemblyContext &ctx, const std::string &value) const {
+        assignMembers(ctx, value, false);
     }
 
-    virtual bool needFinalize() const { return true; }
+    virtual void onMove(AssemblyContext &ctx, const std::string &source) const {
+        assignMembers(ctx, source, true);
+    }
+
+    virtual bool needInitialize() const { return frame.needInitialize(); }
+    virtual bool needFinalize() const { return frame.needFinalize(); }
     virtual void onFinalize(AssemblyContext &ctx) const {
-        if (frame.needFinalize()) {
-            ctx.generate("push {}", REG_FRAME_BASE);
-            ctx.generate("push qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-            ctx.generate("mov {}, qword ptr [{}]", REG_FRAME_BASE, REG_LEFT_VALUE_POINTER);
-            for (auto [name, var] : frame.variables) {
-                var->onFinalize(ctx);
-            }
-            ctx.generate("pop qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-            ctx.generate("pop {}", REG_FRAME_BASE);
-        }
-        ctx.generate("mov rdi, qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-        ctx.generate("lea rax, free[rip]");
-        ctx.generate("call builtin$callsysv");
+        forEachMember(ctx, [](const Type &type) { return type.needFinalize(); }, [&](const Variable &var) {
+            var.type->onFinalize(ctx);
+        });
     }
 
     virtual std::string getSignature() const {
@@ -353,64 +674,29 @@ public:
     }
 };
 
+// The members are laid out inline and contiguously, in row-major order
 class TypeArray : public Type {
     size_t count;
 
-public:
-    std::vector<std::pair<int, int>> bounds;
-    std::shared_ptr<Type> memberType;
-
-    TypeArray(std::vector<std::pair<int, int>> bounds, std::shared_ptr<Type> memberType) : bounds(bounds), memberType(memberType) {
-        count = 1;
-        for (auto [min, max] : bounds) count *= max - min + 1;
-    }
-
-    void onCalculateMemberOffset(AssemblyContext &ctx) const {
-        size_t remainDimsCount = count, i = 0;
-        ctx.generate("xor rax, rax");
-        for (auto [min, max] : bounds) {
-            ctx.generate("push {}", min);
-            ctx.generate("push {}", max);
-            ctx.generate("push {}", ++i);
-            ctx.generate("call builtin$checkarrayindex");
-            ctx.generate("add rsp, 24");
-
-            remainDimsCount /= max - min + 1;
-            ctx.generate("mov rdx, {}", remainDimsCount);
-            ctx.generate("pop rcx"); // Load the index
-            ctx.generate("sub rcx, {}", min);
-            ctx.generate("imul rdx, rcx");
-            ctx.generate("add rax, rdx");
-        }
-    }
-
-    void onLoadMemberPointerToRegister(AssemblyContext &ctx) const {
-        onCalculateMemberOffset(ctx);
-        ctx.generate("lea {}, qword ptr [{} + rax * 8]", REG_LEFT_VALUE_POINTER, REG_FRAME_BASE);
-    }
-
-    virtual void onInitialize(AssemblyContext &ctx) const {
-        ctx.generate("mov rdi, {}", count * 8);
-        ctx.generate("mov rbx, rax");
-        ctx.generate("lea rax, malloc[rip]");
-        ctx.generate("call builtin$callsysv");
-        ctx.generate("mov {}, rax", REG_FRAME_BASE);
-        ctx.generate("mov qword ptr [{}], rax", REG_LEFT_VALUE_POINTER);
-        
-        AssemblyContext ctxEndLoop("ArrayInitializeLoopEnd");
-        ctxEndLoop.generate("add rsp, 8");
-
+    // Generate code for each member with REG_LEFT_VALUE_POINTER pointing to it. In the loop the
+    // array's address is at [rsp + 8], the member's index at [rsp] and its offset in qwords in rax.
+    template <typename Generator>
+    void forEachMember(AssemblyContext &ctx, const std::string &name, Generator generator) const {
+        ctx.generate("push {}", REG_LEFT_VALUE_POINTER);
         ctx.generate("push 0");
 
-        AssemblyContext ctxLoop("ArrayInitializeLoop");
+        AssemblyContext ctxEndLoop(name + "End");
+        ctxEndLoop.generate("add rsp, 16");
+
+        AssemblyContext ctxLoop(name);
         ctxLoop.generate("cmp qword ptr [rsp], {}", count);
         ctxLoop.generate("je {}", ctxEndLoop.getLabel());
 
         ctxLoop.generate("mov rax, qword ptr [rsp]");
-        ctxLoop.generate("lea {}, qword ptr [{} + rax * 8]", REG_LEFT_VALUE_POINTER, REG_FRAME_BASE);
-        ctxLoop.generate("push {}", REG_FRAME_BASE);
-        memberType->onInitialize(ctxLoop);
-        ctxLoop.generate("pop {}", REG_FRAME_BASE);
+        if (getMemberSlots() != 1) ctxLoop.generate("imul rax, rax, {}", getMemberSlots());
+        ctxLoop.generate("mov {}, qword ptr [rsp + 8]", REG_LEFT_VALUE_POINTER);
+        ctxLoop.generate("lea {}, qword ptr [{} + rax * 8]", REG_LEFT_VALUE_POINTER, REG_LEFT_VALUE_POINTER);
+        generator(ctxLoop);
         ctxLoop.generate("inc qword ptr [rsp]");
         ctxLoop.generate("jmp {}", ctxLoop.getLabel());
 
@@ -418,71 +704,107 @@ public:
         ctx.append(std::move(ctxEndLoop));
     }
 
-    virtual void onAssign(AssemblyContext &ctx) const {
-        ctx.generate("mov {}, qword ptr [{}]", REG_FRAME_BASE, REG_LEFT_VALUE_POINTER); // Load the left array's frame address
+    // Moving hands the members' buffers over instead of copying them
+    void assignMembers(AssemblyContext &ctx, const std::string &value, bool move) const {
+        if (!needFinalize()) return generateBulkCopy(ctx, value, getSize());
+
+        ctx.generate("push {}", value);
+        forEachMember(ctx, move ? "ArrayMoveLoop" : "ArrayAssignLoop", [&](AssemblyContext &ctxLoop) {
+            ctxLoop.generate("mov rcx, qword ptr [rsp + 16]"); // The right array's address
+            ctxLoop.generate("{} rax, qword ptr [rcx + rax * 8]", move || memberType->isAggregate() ? "lea" : "mov");
+            if (move) memberType->onMove(ctxLoop, "rax");
+            else memberType->onAssign(ctxLoop, "rax");
+        });
+        ctx.generate("add rsp, 8");
+    }
 
-        AssemblyContext ctxEndLoop("ArrayAssignLoopEnd");
-        ctxEndLoop.generate("add rsp, 8");
+public:
+    std::vector<std::pair<int, int>> bounds;
+    std::shared_ptr<Type> memberType;
 
-        ctx.generate("push 0");
+    TypeArray(std::vector<std::pair<int, int>> bounds, std::shared_ptr<Type> memberType) : bounds(bounds), memberType(memberType) {
+        count = 1;
+        for (auto [min, max] : bounds) count *= max - min + 1;
+    }
 
-        AssemblyContext ctxLoop("ArrayAssignLoop");
-        ctxLoop.generate("cmp qword ptr [rsp], {}", count);
-        ctxLoop.generate("je {}", ctxEndLoop.getLabel());
+    size_t getMemberSlots() const { return memberType->getSize() / 8; }
+
+    // The indexes are temporaries with the first dimension's on the top. An index out of its
+    // dimension's range jumps to a stub in ctxCold, which reports the error and exits.
+    void onCalculateMemberOffset(AssemblyContext &ctx, AssemblyContext &ctxCold, TemporaryAllocator &temporaries, const std::vector<bool> &checks) const {
+        size_t remainDimsCount = count;
+        for (size_t i = 0; i < bounds.size(); i++) {
+            auto [min, max] = bounds[i];
+            auto index = temporaries.get(ctx);
+
+            ctx.generate("mov rcx, {}", index);
+            if (min != 0) ctx.generate("sub rcx, {}", min);
+            if (checks[i]) {
+                // An index below min wraps around to a large unsigned value
+                AssemblyContext ctxFail("ArrayIndexOutOfRange");
+                ctxFail.generate("push {}", index);
+                ctxFail.generate("push {}", min);
+                ctxFail.generate("push {}", max);
+                ctxFail.generate("push {}", i + 1);
+                ctxFail.generate("call builtin$checkarrayindex"); // Doesn't return
+                ctxCold.append(std::move(ctxFail));
+
+                if ((long long)max - min <= INT32_MAX) {
+                    ctx.generate("cmp rcx, {}", (long long)max - min);
+                } else {
+                    ctx.generate("mov rdx, {}", (long long)max - min);
+                    ctx.generate("cmp rcx, rdx");
+                }
+                ctx.generate("ja {}", ctxFail.getLabel());
+            }
 
-        ctxLoop.generate("mov rax, qword ptr [rsp]");
-        ctxLoop.generate("lea {}, qword ptr [{} + rax * 8]", REG_LEFT_VALUE_POINTER, REG_FRAME_BASE); // Load left member
-        ctxLoop.generate("mov rcx, qword ptr [rsp + 8]");
-        ctxLoop.generate("mov rax, qword ptr [rcx + rax * 8]", REG_FRAME_BASE); // Load right member
+            // In qwords
+            remainDimsCount /= max - min + 1;
+            size_t stride = remainDimsCount * getMemberSlots();
+            auto target = i == 0 ? "rax" : "rcx";
+            if (stride == 1) {
+                if (i == 0) ctx.generate("mov rax, rcx");
+            } else if (stride <= INT32_MAX) {
+                ctx.generate("imul {}, rcx, {}", target, stride);
+            } else {
+                ctx.generate("mov rdx, {}", stride);
+                ctx.generate("imul rcx, rdx");
+                if (i == 0) ctx.generate("mov rax, rcx");
+            }
+            if (i != 0) ctx.generate("add rax, rcx");
+            temporaries.pop(ctx);
+        }
+    }
 
-        ctxLoop.generate("push {}", REG_FRAME_BASE);
+    // The array is at REG_LEFT_VALUE_POINTER
+    void onLoadMemberPointerToRegister(AssemblyContext &ctx, AssemblyContext &ctxCold, TemporaryAllocator &temporaries, const std::vector<bool> &checks) const {
+        onCalculateMemberOffset(ctx, ctxCold, temporaries, checks);
+        ctx.generate("lea {}, qword ptr [{} + rax * 8]", REG_LEFT_VALUE_POINTER, REG_LEFT_VALUE_POINTER);
+    }
 
-        ctxLoop.generate("push rax");
-        memberType->onAssign(ctxLoop);
+    virtual size_t getSize() const { return count * memberType->getSize(); }
+    virtual bool isAggregate() const { return true; }
 
-        ctxLoop.generate("pop {}", REG_FRAME_BASE);
-        ctxLoop.generate("inc qword ptr [rsp]");
-        ctxLoop.generate("jmp {}", ctxLoop.getLabel());
+    virtual void onInitialize(AssemblyContext &ctx) const {
+        forEachMember(ctx, "ArrayInitializeLoop", [&](AssemblyContext &ctxLoop) {
+            memberType->onInitialize(ctxLoop);
+        });
+    }
 
-        ctx.append(std::move(ctxLoop));
-        ctx.append(std::move(ctxEndLoop));
+    virtual void onAssign(AssemblyContext &ctx, const std::string &value) const {
+        assignMembers(ctx, value, false);
+    }
 
-        ctx.generate("add rsp, 8");
+    virtual void onMove(AssemblyContext &ctx, const std::string &source) const {
+        assignMembers(ctx, source, true);
     }
 
-    virtual bool needFinalize() const { return true; }
+    virtual bool needInitialize() const { return memberType->needInitialize(); }
+    virtual bool needFinalize() const { return memberType->needFinalize(); }
     virtual void onFinalize(AssemblyContext &ctx) const {
-        if (memberType->needFinalize()) {
-            ctx.generate("push rbx");
-            ctx.generate("push qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-            ctx.generate("mov rbx, qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-
-            AssemblyContext ctxEndLoop("ArrayFinalizeLoopEnd");
-            ctxEndLoop.generate("add rsp, 8");
-
-            ctx.generate("push 0");
-
-            AssemblyContext ctxLoop("ArrayFinalizeLoop");
-            ctxLoop.generate("cmp qword ptr [rsp], {}", count);
-            ctxLoop.generate("je {}", ctxEndLoop.getLabel());
-
-            ctxLoop.generate("mov rax, qword ptr [rsp]");
-            ctxLoop.generate("lea {}, qword ptr [{} + rax * 8]", REG_LEFT_VALUE_POINTER, REG_FRAME_BASE);
-            ctxLoop.generate("push {}", REG_FRAME_BASE);
+        forEachMember(ctx, "ArrayFinalizeLoop", [&](AssemblyContext &ctxLoop) {
             memberType->onFinalize(ctxLoop);
-            ctxLoop.generate("pop {}", REG_FRAME_BASE);
-            ctxLoop.generate("inc qword ptr [rsp]");
-            ctxLoop.generate("jmp {}", ctxLoop.getLabel());
-
-            ctx.append(std::move(ctxLoop));
-            ctx.append(std::move(ctxEndLoop));
-
-            ctx.generate("pop qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-            ctx.generate("pop rbx");
-        }
-        ctx.generate("mov rdi, qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-        ctx.generate("lea rax, free[rip]");
-        ctx.generate("call builtin$callsysv");
+        });
     }
 
     virtual std::string getSignature() const {
@@ -507,6 +829,20 @@ public:
     bool isBuiltinFunction;
     size_t level;
     std::string label;
+    // Non-null if the function only assigns an expression of its value parameters to its result,
+    // without calls, so its calls can be expanded inline
+    std::shared_ptr<AST::Expression> inlineBody;
+    std::string inlineRejection; // Why inlineBody is null
+    size_t inlineCost = 0;
+    // Where the parameters are passed in order, or empty if they're all pushed on the machine stack
+    std::vector<std::string> argumentRegisters;
+
+    size_t getStackArguments() const { return argumentRegisters.empty() ? parameters.size() : 0; }
+
+    // The program's variables are static, so functions nested directly in it don't need its frame
+    bool needStaticLink() const {
+        return options.nonLocalAccess == NonLocalAccess::StaticLink && level > 1;
+    }
 
     // For user-defined functions
     Function() {}
@@ -625,9 +961,7 @@ std::vector<std::shared_ptr<Function>> builtinFunctions = {
     )
 };
 
-AssemblyContext constsContext("Constants");
-
-class Block {
+class Block : public IR::Resolver {
 public:
     std::shared_ptr<Function> function;
     std::map<std::string, std::shared_ptr<Symbol>> symbolTable;
@@ -637,13 +971,111 @@ public:
     size_t level;
     std::string label;
     AssemblyContext ctx;
+    AssemblyContext ctxCold; // Placed after the function's return
+    TemporaryAllocator temporaries;
+    std::vector<std::string> savedRegisters;
+    size_t frameSize = 0; // The local variables' qwords
+    // The level whose frame REG_FRAME_BASE is known to point to at the current emission point
+    std::optional<size_t> frameBaseLevel;
+    // The values the loop variables of the enclosing for statements take in their bodies
+    std::map<std::shared_ptr<Variable>, std::pair<long long, long long>> loopRanges;
+
+    using VariableSet = std::set<std::shared_ptr<Variable>>;
+    // Where the variables of this block considered for coalescing are read and written
+    struct LivenessPoint {
+        VariableSet uses, kills, defines, liveOut;
+        bool hasCall = false; // The variables read may be written as well
+        bool storesBuffer = true; // Whether what's written may own a buffer
+        const AST::AssignmentStatement *assignment = nullptr;
+        std::shared_ptr<Variable> target, source; // Of a whole variable assignment
+    };
+    VariableSet coalescingCandidates;
+    std::vector<LivenessPoint> livenessPoints;
+    std::map<const void *, size_t> livenessPointIndexes; // By the statement or expression
+    // The assignments whose source variable is dead afterwards, so its buffers are handed over
+    std::set<const AST::AssignmentStatement *> movedAssignments;
+    // While expanding a call inline, the callee's names resolve in its scope, except its parameters,
+    // which are bound to the temporaries (by index from the bottom) holding the arguments
+    const Block *inlineScope = nullptr;
+    std::map<std::string, std::pair<size_t, std::shared_ptr<Type>>> inlineParameters;
+    // The calls of the function to itself that are the last thing it does, which jump back to
+    // tailCallLabel with the frame reused
+    std::set<const AST::Statement *> tailCalls;
+    std::string tailCallLabel;
+    // The functions this block calls, which the program reaches if it reaches this block
+    std::set<Function *> callees;
+    // The elements an innermost loop indexes by its for variable or by invariants only are reached
+    // through pointers kept in the frame, advanced along with the variable. The invariant values
+    // worth it are computed before the loop into the frame as well.
+    struct InductionPointer {
+        std::shared_ptr<AST::ArrayAccessExpression> access; // Evaluated before the loop
+        std::shared_ptr<Type> type;
+        ssize_t frameOffset;
+        long long step; // In bytes, per iteration upwards
+    };
+    struct LoopInvariant {
+        std::shared_ptr<AST::Expression> expr;
+        ssize_t frameOffset;
+        std::shared_ptr<Type> type; // Once evaluated
+    };
+    // A for loop going up whose body is a single assignment of element-wise operations on the
+    // elements its pointers step through, also run a vector of iterations at a time before the scalar
+    // loop finishes the rest. It stores the elements, or adds up integers into a variable.
+    struct VectorLoop {
+        std::shared_ptr<AST::Expression> value; // Computed lane by lane
+        bool isDouble;
+        std::shared_ptr<AST::ArrayAccessExpression> store; // Or null for a sum
+        std::shared_ptr<Variable> sum;
+        bool subtracts; // The value from the sum
+        std::vector<std::shared_ptr<AST::Expression>> broadcasts; // Invariant operands, evaluated once
+    };
+    struct LoopPlan {
+        std::vector<InductionPointer> pointers;
+        std::map<const AST::ArrayAccessExpression *, size_t> accesses; // Their pointers
+        // The values of the variables indexing through the pointers that keep them in bounds
+        std::map<std::shared_ptr<Variable>, std::pair<long long, long long>> bounds;
+        std::vector<LoopInvariant> invariants;
+        std::map<const AST::Expression *, size_t> invariantIndexes;
+        std::optional<VectorLoop> vectorLoop;
+
+        size_t getSlots() const { return pointers.size() + invariants.size(); }
+    };
+    // What can change in a loop other than the variables it assigns by name
+    struct LoopScope {
+        std::shared_ptr<AST::Statement> body;
+        std::string variable; // Of a for loop
+        bool hasHiddenWrites; // Through pointers, references or calls
+    };
+    std::map<const AST::Statement *, LoopPlan> loopPlans;
+    const LoopPlan *currentLoopPlan = nullptr; // Whose body is being generated
+    // Along a run of straight-line statements, the values and element addresses computed more than
+    // once are saved to the frame the first time and reloaded after, until a store or call may
+    // change them. They're identified by keys built from the expressions' structure.
+    struct SavedValue {
+        ssize_t frameOffset;
+        std::shared_ptr<Type> type;
+        std::set<std::string> variables; // Read to compute it
+        bool isLocal; // Reading only variables no store through a pointer or reference, or call can change
+    };
+    std::vector<std::map<std::string, ssize_t>> valueSlots; // Of the values each run saves
+    std::map<const AST::Statement *, std::pair<size_t, size_t>> straightLinePositions; // The run and index in it
+    const std::map<std::string, ssize_t> *currentValueSlots = nullptr; // Of the run being generated
+    const AST::Statement *lastStraightLine = nullptr; // Generated last, if in a run
+    std::map<std::string, SavedValue> savedValues;
+    size_t eliminatedExpressions = 0;
+    std::map<const Variable *, std::shared_ptr<IR::Slot>> irSlots;
 
     Block(std::shared_ptr<Function> function, Block *parentBlock, std::shared_ptr<AST::Block> astBlock)
     : function(function),
       typeAliases(parentBlock ? parentBlock->typeAliases : builtinTypes),
       parentBlock(parentBlock),
       level(parentBlock ? parentBlock->level + 1 : 0),
-      ctx("Function") {
+      ctx("Function"),
+      ctxCold("Cold") {
+        // The nested blocks, generated first, may call this one
+        label = ctx.getLabel();
+        if (function) function->label = label;
+
         if (!parentBlock) {
             // Add all built-in functions to the root block
             for (auto func : builtinFunctions) symbolTable[func->name] = func;
@@ -654,24 +1086,34 @@ public:
         }
 
         for (auto astConstant : astBlock->constants) {
-            auto constant = std::make_shared<Constant>(astConstant->value);
-            constant->generate(constsContext);
-            symbolTable[astConstant->name] = constant;
+            symbolTable[astConstant->name] = std::make_shared<Constant>(astConstant->value);
         }
 
-        size_t i = 0;
         for (auto astVariable : astBlock->variables) {
-            auto variable = std::make_shared<Variable>(resolveAstType(astVariable->type), --i);
+            auto type = resolveAstType(astVariable->type);
+            std::shared_ptr<Variable> variable;
+            if (!parentBlock) {
+                // The program's variables live in .bss
+                variable = std::make_shared<Variable>(type, 0);
+                variable->symbol = ".Global_" + astVariable->name;
+            } else {
+                // Each variable's slots end where the previous one's begin
+                frameSize += type->getSize() / 8;
+                variable = std::make_shared<Variable>(type, -(ssize_t)frameSize);
+            }
             symbolTable[astVariable->name] = variable;
             frame.variables[astVariable->name] = variable;
         }
 
         if (function) {
-            ssize_t i = 0, nParams = function->parameters.size();
+            // The ones passed in registers get slots once it's known which stay in memory, except that
+            // the nested blocks may access them before
+            ssize_t i = 0, nParams = function->getStackArguments();
             for (auto [name, isReference, type] : function->parameters) {
-                auto parameter = std::make_shared<Variable>(type, (nParams + 1) - i++, isReference);
+                auto parameter = std::make_shared<Variable>(type, nParams ? (nParams + 1) - i++ : 0, isReference);
                 symbolTable[name] = parameter;
             }
+            if (!astBlock->callables.empty()) allocateParameterSlots();
         }
 
         for (auto astCallable : astBlock->callables) {
@@ -680,15 +1122,87 @@ public:
             symbolTable[astCallable->name] = func;
         }
 
+        // The nested blocks have marked the variables they access by now
+        promoteVariables(astBlock);
+        buildIR(astBlock);
+        checkStatementTypes(astBlock->statement);
+        if (function) allocateParameterSlots();
+        coalesceVariables(astBlock);
+        if (function && options.tailCalls && allowsTailCalls()) findTailCalls(astBlock->statement);
+        size_t variablesSize = frameSize;
+        if (options.inductionPointers || options.loopInvariantMotion) {
+            // The loops don't nest, so they share the slots
+            size_t slots = 0;
+            findLoopPlans(astBlock->statement, slots);
+            frameSize += slots;
+        }
+        if (options.commonSubexpressions) {
+            // So do the runs
+            size_t slots = 0;
+            findRepeatedValues(astBlock->statement, nullptr, slots);
+            frameSize += slots;
+        }
+
+        // The display entry of this level is saved after the callee-saved registers
+        bool useDisplay = options.nonLocalAccess == NonLocalAccess::Display;
+        size_t savedDisplayOffset = (frameSize + savedRegisters.size() + 1) * 8;
+
+        // A function with all its variables in registers and no slots needs no frame, unless it's
+        // reached through the static links or the display, and saves the registers on the machine stack
+        bool isFrameless = function && options.frameOmission && !useDisplay && !function->needStaticLink() &&
+                           astBlock->callables.empty() && function->getStackArguments() == 0 && frameSize == variablesSize;
+        for (auto [name, sym] : symbolTable) {
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (var && !var->isPromoted()) isFrameless = false;
+        }
+
         // Generate code
-        ctx.generate("push rbp");
-        ctx.generate("mov rbp, rsp");
-        ctx.generate("sub rsp, {}", astBlock->variables.size() * 8);
+        if (isFrameless) {
+            for (auto &reg : savedRegisters) TemporaryAllocator::pushRegister(ctx, reg);
+        } else {
+            ctx.generate("push rbp");
+            ctx.generate("mov rbp, rsp");
+            ctx.generate("sub rsp, {}", (frameSize + savedRegisters.size() + (useDisplay && level > 0)) * 8);
+
+            // The callee-saved registers are saved after the local variables
+            for (size_t i = 0; i < savedRegisters.size(); i++) {
+                auto reg = savedRegisters[i];
+                ctx.generate("{} qword ptr [rbp - {}], {}", getMoveInstruction(reg), (frameSize + i + 1) * 8, reg);
+            }
+        }
 
-        label = ctx.getLabel();
-        if (function) function->label = label;
+        if (useDisplay) {
+            if (level > 0) {
+                ctx.generate("mov rax, {}", getDisplayOperand(level));
+                ctx.generate("mov qword ptr [rbp - {}], rax", savedDisplayOffset);
+            }
+            ctx.generate("mov {}, rbp", getDisplayOperand(level));
+        }
+
+        // Before the zero-fill, which may clobber them
+        if (function) {
+            for (size_t i = 0; i < function->argumentRegisters.size(); i++) generateParameterStore(ctx, i, function->argumentRegisters[i]);
+        }
+
+        // The callee-saved registers, static link and display entry stay as they are on restarting,
+        // the tail calls store the parameters passed in registers themselves
+        if (!tailCalls.empty()) {
+            AssemblyContext ctxRestart("TailCall");
+            tailCallLabel = ctxRestart.getLabel();
+            ctx.append(std::move(ctxRestart));
+        }
+
+        generateZeroFill();
+
+        for (auto [name, sym] : symbolTable) {
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (var && var->isPromoted() && var->frameOffset > 0) {
+                // Load the parameter
+                ctx.generate("{} {}, qword ptr [rbp + {}]", getMoveInstruction(var->reg), var->reg, var->frameOffset * 8);
+            }
+        }
 
-        loadFrame(ctx, level);
+        if (!isFrameless) loadFrame(ctx, level);
         frame.onInitialize(ctx);
         ctx.append(generateStatement(astBlock->statement));
         if (frame.needFinalize()) {
@@ -696,23 +1210,1286 @@ public:
             frame.onFinalize(ctx);
         }
 
-        ctx.generate("leave");
-        ctx.generate("ret");
+        if (isFrameless) {
+            for (size_t i = savedRegisters.size(); i-- > 0; ) {
+                auto reg = savedRegisters[i];
+                if (isDoubleRegister(reg)) {
+                    ctx.generate("movsd {}, qword ptr [rsp]", reg);
+                    ctx.generate("add rsp, 8");
+                } else
+                    ctx.generate("pop {}", reg);
+            }
+            ctx.generate("ret");
+        } else {
+            for (size_t i = 0; i < savedRegisters.size(); i++) {
+                auto reg = savedRegisters[i];
+                ctx.generate("{} {}, qword ptr [rbp - {}]", getMoveInstruction(reg), reg, (frameSize + i + 1) * 8);
+            }
+
+            if (useDisplay && level > 0) {
+                ctx.generate("mov rax, qword ptr [rbp - {}]", savedDisplayOffset);
+                ctx.generate("mov {}, rax", getDisplayOperand(level));
+            }
+
+            ctx.generate("leave");
+            ctx.generate("ret");
+        }
+        ctx.append(std::move(ctxCold));
 
         blocks.push_back(this);
     }
 
-    std::shared_ptr<Type> resolveAstType(std::shared_ptr<AST::Type> astType) {
-        if (auto astRecordType = std::dynamic_pointer_cast<AST::RecordType>(astType)) {
-            std::map<std::string, std::shared_ptr<Variable>> variables;
+    // Weigh the uses of this block's variables and mark the escaping ones
+    void analyzeExpression(std::shared_ptr<AST::Expression> expr, std::map<std::shared_ptr<Variable>, size_t> &uses, size_t weight) {
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto [slevel, sym] = resolveSymbol(ex->identifier);
+            if (auto var = std::dynamic_pointer_cast<Variable>(sym); var && slevel == level) uses[var] += weight;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            analyzeExpression(ex->record, uses, weight);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            analyzeExpression(ex->array, uses, weight);
+            for (auto index : ex->indexes) analyzeExpression(index, uses, weight);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            analyzeExpression(ex->pointer, uses, weight);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            analyzeExpression(ex->leftOperand, uses, weight);
+            analyzeExpression(ex->rightOperand, uses, weight);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            if (ex->op == AST::UnaryOperator::At) markEscaping(ex->operand);
+            analyzeExpression(ex->operand, uses, weight);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            auto [slevel, sym] = resolveSymbol(ex->functionName);
+            auto func = std::dynamic_pointer_cast<Function>(sym);
             size_t i = 0;
-            for (auto astVariable : astRecordType->variables) {
-                if (variables.find(astVariable->name) != variables.end()) {
+            for (auto argument : ex->argumentList) {
+                if (func && i < func->parameters.size() && std::get<1>(func->parameters[i++])) markEscaping(argument);
+                analyzeExpression(argument, uses, weight);
+            }
+        }
+    }
+
+    void analyzeStatement(std::shared_ptr<AST::Statement> stmt, std::map<std::shared_ptr<Variable>, size_t> &uses, size_t weight) {
+        const size_t LOOP_WEIGHT = 8;
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            analyzeExpression(st->left, uses, weight);
+            analyzeExpression(st->right, uses, weight);
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) analyzeStatement(sub, uses, weight);
+        } else if (auto st = std::dynamic_pointer_cast<AST::WhileStatement>(stmt)) {
+            analyzeExpression(st->condition, uses, weight * LOOP_WEIGHT);
+            analyzeStatement(st->statement, uses, weight * LOOP_WEIGHT);
+        } else if (auto st = std::dynamic_pointer_cast<AST::RepeatStatement>(stmt)) {
+            analyzeExpression(st->condition, uses, weight * LOOP_WEIGHT);
+            analyzeStatement(st->statement, uses, weight * LOOP_WEIGHT);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ForStatement>(stmt)) {
+            analyzeExpression(std::make_shared<AST::IdentifierExpression>(st->variable), uses, weight * LOOP_WEIGHT * 2);
+            analyzeExpression(st->initialValue, uses, weight);
+            analyzeExpression(st->finalValue, uses, weight);
+            analyzeStatement(st->statement, uses, weight * LOOP_WEIGHT);
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            analyzeExpression(st->condition, uses, weight);
+            analyzeStatement(st->statementForTrue, uses, weight);
+            analyzeStatement(st->statementForFalse, uses, weight);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+            analyzeExpression(st->expression, uses, weight);
+        }
+    }
+
+    std::shared_ptr<Variable> getCoalescingCandidate(std::shared_ptr<AST::Expression> expr) const {
+        auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr);
+        if (!ex) return nullptr;
+        auto [slevel, sym] = resolveSymbol(ex->identifier);
+        auto var = std::dynamic_pointer_cast<Variable>(sym);
+        return slevel == level && coalescingCandidates.count(var) ? var : nullptr;
+    }
+
+    void collectUses(std::shared_ptr<AST::Expression> expr, LivenessPoint &point) const {
+        if (auto var = getCoalescingCandidate(expr)) {
+            point.uses.insert(var);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            collectUses(ex->record, point);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            collectUses(ex->array, point);
+            for (auto index : ex->indexes) collectUses(index, point);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            collectUses(ex->pointer, point);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            collectUses(ex->leftOperand, point);
+            collectUses(ex->rightOperand, point);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            collectUses(ex->operand, point);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            for (auto argument : ex->argumentList) collectUses(argument, point);
+            point.hasCall = true;
+        }
+    }
+
+    // The type of a member or element of a variable, without reporting errors
+    std::shared_ptr<Type> getLeftValueType(std::shared_ptr<AST::MaybeLeftValueExpression> expr) const {
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto var = std::dynamic_pointer_cast<Variable>(resolveSymbol(ex->identifier).second);
+            return var ? var->type : nullptr;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            auto type = std::dynamic_pointer_cast<TypeRecord>(getLeftValueType(ex->record));
+            auto member = type ? type->findMember(ex->member) : nullptr;
+            return member ? member->type : nullptr;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            auto type = std::dynamic_pointer_cast<TypeArray>(getLeftValueType(ex->array));
+            return type ? type->memberType : nullptr;
+        }
+        return nullptr;
+    }
+
+    // Writing a member or an element keeps the rest of the variable's value
+    void collectPartialDefinition(std::shared_ptr<AST::MaybeLeftValueExpression> expr, LivenessPoint &point) const {
+        if (auto var = getCoalescingCandidate(expr)) {
+            point.defines.insert(var);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            collectPartialDefinition(ex->record, point);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            collectPartialDefinition(ex->array, point);
+            for (auto index : ex->indexes) collectUses(index, point);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            collectUses(ex->pointer, point);
+        }
+    }
+
+    // Record the point and return the variables live before it
+    VariableSet visitLivenessPoint(const void *key, LivenessPoint point, const VariableSet &liveOut) {
+        point.liveOut = liveOut;
+        // The arguments passed to a call may be written through
+        if (point.hasCall) point.defines.insert(point.uses.begin(), point.uses.end());
+
+        VariableSet liveIn = liveOut;
+        for (auto var : point.kills) liveIn.erase(var);
+        liveIn.insert(point.uses.begin(), point.uses.end());
+
+        auto [it, inserted] = livenessPointIndexes.try_emplace(key, livenessPoints.size());
+        if (inserted) livenessPoints.push_back(std::move(point));
+        else livenessPoints[it->second] = std::move(point);
+        return liveIn;
+    }
+
+    VariableSet visitLivenessExpression(std::shared_ptr<AST::Expression> expr, const VariableSet &liveOut) {
+        LivenessPoint point;
+        collectUses(expr, point);
+        return visitLivenessPoint(expr.get(), std::move(point), liveOut);
+    }
+
+    static VariableSet join(VariableSet a, const VariableSet &b) {
+        a.insert(b.begin(), b.end());
+        return a;
+    }
+
+    // Backward liveness over the structured statements, iterating the loops to a fixed point. The
+    // points are recorded again on each iteration, so they end up with the final live sets.
+    VariableSet computeLiveIn(std::shared_ptr<AST::Statement> stmt, const VariableSet &liveOut) {
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            LivenessPoint point;
+            point.assignment = st.get();
+            collectUses(st->right, point);
+            point.source = getCoalescingCandidate(st->right);
+            if ((point.target = getCoalescingCandidate(st->left))) {
+                point.kills.insert(point.target);
+                point.defines.insert(point.target);
+            } else {
+                collectPartialDefinition(st->left, point);
+                auto type = getLeftValueType(st->left);
+                point.storesBuffer = point.hasCall || !type || type->needFinalize();
+            }
+            return visitLivenessPoint(st.get(), std::move(point), liveOut);
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            VariableSet live = liveOut;
+            for (auto it = st->statements.rbegin(); it != st->statements.rend(); it++) live = computeLiveIn(*it, live);
+            return live;
+        } else if (auto st = std::dynamic_pointer_cast<AST::WhileStatement>(stmt)) {
+            VariableSet head = liveOut;
+            while (true) {
+                auto afterCondition = join(liveOut, computeLiveIn(st->statement, head));
+                auto newHead = visitLivenessExpression(st->condition, afterCondition);
+                if (newHead == head) return head;
+                head = std::move(newHead);
+            }
+        } else if (auto st = std::dynamic_pointer_cast<AST::RepeatStatement>(stmt)) {
+            VariableSet head;
+            while (true) {
+                auto beforeCondition = visitLivenessExpression(st->condition, join(liveOut, head));
+                auto newHead = computeLiveIn(st->statement, beforeCondition);
+                if (newHead == head) return head;
+                head = std::move(newHead);
+            }
+        } else if (auto st = std::dynamic_pointer_cast<AST::ForStatement>(stmt)) {
+            VariableSet head = liveOut;
+            while (true) {
+                auto newHead = join(liveOut, computeLiveIn(st->statement, head));
+                if (newHead == head) break;
+                head = std::move(newHead);
+            }
+            return visitLivenessExpression(st->initialValue, visitLivenessExpression(st->finalValue, head));
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            auto branches = join(computeLiveIn(st->statementForTrue, liveOut), computeLiveIn(st->statementForFalse, liveOut));
+            return visitLivenessExpression(st->condition, branches);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+            return visitLivenessExpression(st->expression, liveOut);
+        }
+        return liveOut;
+    }
+
+    // A variable copied into another as a whole shares its storage when their values never need to
+    // coexist, which makes the copy a no-op. Otherwise a source not used afterwards hands its buffers
+    // over to the destination instead of having them copied.
+    void coalesceVariables(std::shared_ptr<AST::Block> astBlock) {
+        for (auto [name, var] : frame.variables) {
+            if (!var->isEscaping && !var->isReference && !var->isPromoted() && !var->type->isPlain())
+                coalescingCandidates.insert(var);
+        }
+        if (coalescingCandidates.empty()) return;
+        computeLiveIn(astBlock->statement, {});
+
+        // A definition conflicts with the values live after it, except the one a copy's target gets.
+        // All the variables start zero-filled, so they don't conflict before being written.
+        std::map<std::shared_ptr<Variable>, VariableSet> interference;
+        for (auto &point : livenessPoints) {
+            auto conflicts = point.hasCall ? join(point.liveOut, point.uses) : point.liveOut;
+            for (auto var : point.defines) {
+                for (auto other : conflicts) {
+                    if (other == var || (var == point.target && other == point.source)) continue;
+                    interference[var].insert(other);
+                    interference[other].insert(var);
+                }
+            }
+        }
+
+        std::map<std::shared_ptr<Variable>, std::shared_ptr<VariableSet>> classes;
+        for (auto var : coalescingCandidates) classes[var] = std::make_shared<VariableSet>(VariableSet{var});
+        for (auto &point : livenessPoints) {
+            if (!point.target || !point.source || *point.target->type != *point.source->type) continue;
+            auto a = classes[point.target], b = classes[point.source];
+            if (a == b) continue;
+
+            bool interfering = false;
+            for (auto var : *a)
+                for (auto other : *b) interfering = interfering || interference[var].count(other);
+            if (interfering) continue;
+
+            for (auto var : *b) {
+                a->insert(var);
+                classes[var] = a;
+            }
+        }
+
+        // The variable declared first in each class keeps the storage
+        std::map<std::shared_ptr<Variable>, std::shared_ptr<Variable>> representatives;
+        for (auto [name, var] : frame.variables) {
+            if (!coalescingCandidates.count(var)) continue;
+            for (auto member : *classes[var]) representatives.try_emplace(member, var);
+        }
+        for (auto it = frame.variables.begin(); it != frame.variables.end(); ) {
+            auto representative = representatives.find(it->second);
+            if (representative != representatives.end() && representative->second != it->second) {
+                symbolTable[it->first] = representative->second;
+                it = frame.variables.erase(it);
+            } else it++;
+        }
+
+        VariableSet written;
+        for (auto &point : livenessPoints) {
+            if (point.storesBuffer) written.insert(point.defines.begin(), point.defines.end());
+            if (!point.source || !point.source->type->needFinalize()) continue;
+            if (point.target && classes[point.target] == classes[point.source]) continue;
+
+            bool dead = true;
+            for (auto var : *classes[point.source]) dead = dead && !point.liveOut.count(var);
+            if (dead) {
+                movedAssignments.insert(point.assignment);
+                written.insert(point.source); // Gets the destination's buffer
+            }
+        }
+
+        // Nothing outside this block can reach the candidates, so one never written here keeps its
+        // initial value and owns no buffer to free
+        for (auto [name, var] : frame.variables) {
+            if (!coalescingCandidates.count(var)) continue;
+            var->isWritten = false;
+            for (auto member : *classes[var]) var->isWritten = var->isWritten || written.count(member);
+        }
+    }
+
+    // Restarting the function invalidates the frame, so nothing may point into it. A reference
+    // parameter's escaping address is the one it holds.
+    bool allowsTailCalls() const {
+        for (auto [name, sym] : symbolTable) {
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (var && var->isEscaping && !var->isReference) return false;
+        }
+        return true;
+    }
+
+    // The function's own name always resolves to itself in its block
+    bool isSelfCall(std::shared_ptr<AST::Expression> expr) const {
+        if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) return ex->functionName == function->name;
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) return ex->identifier == function->name;
+        return false;
+    }
+
+    // A function's result must be assigned the call's, a procedure's call must be a statement
+    void findTailCalls(std::shared_ptr<AST::Statement> stmt) {
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            auto lv = std::dynamic_pointer_cast<AST::IdentifierExpression>(st->left);
+            if (function->returnType && lv && lv->identifier == function->name && isSelfCall(st->right)) tailCalls.insert(st.get());
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExplicitCallStatement>(stmt)) {
+            if (!function->returnType && st->functionName == function->name) tailCalls.insert(st.get());
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+            if (!function->returnType && isSelfCall(st->expression)) tailCalls.insert(st.get());
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto it = st->statements.rbegin(); it != st->statements.rend(); it++) {
+                if (*it && !std::dynamic_pointer_cast<AST::EmptyStatement>(*it)) {
+                    findTailCalls(*it);
+                    break;
+                }
+            }
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            findTailCalls(st->statementForTrue);
+            findTailCalls(st->statementForFalse);
+        }
+    }
+
+    // Like resolveSymbol(), but null instead of reporting an error
+    std::pair<size_t, std::shared_ptr<Symbol>> findSymbol(const std::string &symbolName) const {
+        for (auto block = this; block; block = block->parentBlock) {
+            if (block->function && symbolName == block->function->name) return {block->level - 1, block->function};
+            if (auto it = block->symbolTable.find(symbolName); it != block->symbolTable.end()) return {block->level, it->second};
+        }
+        return {0, nullptr};
+    }
+
+    static IR::Type getIRType(std::shared_ptr<Type> type) {
+        if (isDoubleType(type)) return IR::Type::Double;
+        if (std::dynamic_pointer_cast<TypeInteger>(type)) return IR::Type::Integer;
+        return IR::Type::Other;
+    }
+
+    IR::Name resolveName(const std::string &name) override {
+        IR::Name result;
+        auto sym = findSymbol(name).second;
+        if (auto var = std::dynamic_pointer_cast<Variable>(sym)) {
+            result.kind = IR::Name::Kind::Variable;
+            // This block's own are made before lowering, the outer ones are only loaded and stored
+            auto &slot = irSlots[var.get()];
+            if (!slot) slot = std::make_shared<IR::Slot>(IR::Slot{name, getIRType(var->type), false, var->isReference, false});
+            result.slot = slot;
+        } else if (auto cst = std::dynamic_pointer_cast<Constant>(sym)) {
+            result.kind = IR::Name::Kind::Constant;
+            result.literal = cst->literalValue;
+        } else if (auto func = std::dynamic_pointer_cast<Function>(sym)) {
+            result.kind = IR::Name::Kind::Callable;
+            for (auto &parameter : func->parameters) result.signature.byReference.push_back(std::get<1>(parameter));
+            result.signature.returnType = func->returnType ? getIRType(func->returnType) : IR::Type::Void;
+            result.isCurrentFunction = func == function;
+        }
+        return result;
+    }
+
+    IR::Type getLoadType(std::shared_ptr<AST::MaybeLeftValueExpression> expr) override {
+        auto type = getLeftValueType(expr);
+        return type ? getIRType(type) : IR::Type::Other;
+    }
+
+    // Lower the body to SSA form and run SCCP on it, before any analysis that applies the results.
+    // The variables that nothing else accesses, which are known once promoteVariables has run,
+    // hold SSA values
+    void buildIR(std::shared_ptr<AST::Block> astBlock) {
+        std::vector<std::shared_ptr<IR::Slot>> slots;
+        auto addSlot = [&](const std::string &name, bool isParameter) {
+            // Skip the ones hidden by a parameter or a function of the same name
+            auto var = std::dynamic_pointer_cast<Variable>(symbolTable[name]);
+            if (!var || irSlots.count(var.get())) return;
+            auto type = getIRType(var->type);
+            bool promotable = !var->isEscaping && !var->isReference && type != IR::Type::Other;
+            slots.push_back(irSlots[var.get()] = std::make_shared<IR::Slot>(IR::Slot{name, type, isParameter, var->isReference, promotable}));
+        };
+        if (function) {
+            for (auto [name, isReference, type] : function->parameters) addSlot(name, true);
+        }
+        for (auto astVariable : astBlock->variables) addSlot(astVariable->name, false);
+
+        std::shared_ptr<IR::Slot> resultSlot;
+        if (function && function->returnType)
+            resultSlot = std::make_shared<IR::Slot>(IR::Slot{function->name, getIRType(function->returnType), false, false, false});
+
+        auto irFunction = IR::Builder(*this).build(function ? function->name : "(program)", astBlock, std::move(slots), resultSlot);
+        if (auto error = irFunction->findUndefinedOperand()) reportError("Bug! Invalid IR in {}: {}", irFunction->name, *error);
+        for (auto &[expr, value] : irFunction->values) expressionTypes[expr] = value->type;
+        // Without a run no expression has a known constant, so getImmediate, getRange and the others fall back
+        if (options.constantPropagation) constantPropagation.run(*irFunction);
+        if (options.dumpIR) irFunction->printTo(std::cerr);
+    }
+
+    static bool containsLoop(std::shared_ptr<AST::Statement> stmt) {
+        if (std::dynamic_pointer_cast<AST::WhileStatement>(stmt) || std::dynamic_pointer_cast<AST::RepeatStatement>(stmt) ||
+            std::dynamic_pointer_cast<AST::ForStatement>(stmt)) return true;
+        if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) if (containsLoop(sub)) return true;
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            return containsLoop(st->statementForTrue) || containsLoop(st->statementForFalse);
+        }
+        return false;
+    }
+
+    static void collectArrayAccesses(std::shared_ptr<AST::Expression> expr, std::vector<std::shared_ptr<AST::ArrayAccessExpression>> &accesses) {
+        if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            collectArrayAccesses(ex->record, accesses);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            accesses.push_back(ex);
+            collectArrayAccesses(ex->array, accesses);
+            for (auto index : ex->indexes) collectArrayAccesses(index, accesses);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            collectArrayAccesses(ex->pointer, accesses);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            collectArrayAccesses(ex->leftOperand, accesses);
+            collectArrayAccesses(ex->rightOperand, accesses);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            collectArrayAccesses(ex->operand, accesses);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            for (auto argument : ex->argumentList) collectArrayAccesses(argument, accesses);
+        }
+    }
+
+    // Of a loop body
+    static void collectStatementArrayAccesses(std::shared_ptr<AST::Statement> stmt, std::vector<std::shared_ptr<AST::ArrayAccessExpression>> &accesses) {
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            collectArrayAccesses(st->left, accesses);
+            collectArrayAccesses(st->right, accesses);
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) collectStatementArrayAccesses(sub, accesses);
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            collectArrayAccesses(st->condition, accesses);
+            collectStatementArrayAccesses(st->statementForTrue, accesses);
+            collectStatementArrayAccesses(st->statementForFalse, accesses);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+            collectArrayAccesses(st->expression, accesses);
+        }
+    }
+
+    // An index of the form u, u + c, u - c or c + u, where u is an integer variable of this block,
+    // or c alone, with a null variable
+    struct AffineIndex {
+        std::shared_ptr<Variable> var;
+        std::string name;
+        long long offset;
+    };
+    std::optional<AffineIndex> getAffineIndex(std::shared_ptr<AST::Expression> expr) const {
+        const long long LIMIT = 1LL << 30;
+        if (auto immediate = getImmediate(expr)) {
+            if (*immediate < -LIMIT || *immediate > LIMIT) return std::nullopt;
+            return AffineIndex{nullptr, "", *immediate};
+        }
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto [slevel, sym] = findSymbol(ex->identifier);
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (!var || slevel != level || !std::dynamic_pointer_cast<TypeInteger>(var->type)) return std::nullopt;
+            return AffineIndex{var, ex->identifier, 0};
+        }
+        auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr);
+        if (!ex || (ex->op != AST::BinaryOperator::Plus && ex->op != AST::BinaryOperator::Minus)) return std::nullopt;
+        auto l = getAffineIndex(ex->leftOperand), r = getAffineIndex(ex->rightOperand);
+        if (!l || !r || (l->var && r->var) || (ex->op == AST::BinaryOperator::Minus && r->var)) return std::nullopt;
+        long long offset = ex->op == AST::BinaryOperator::Plus ? l->offset + r->offset : l->offset - r->offset;
+        if (offset < -LIMIT || offset > LIMIT) return std::nullopt;
+        return l->var ? AffineIndex{l->var, l->name, offset} : AffineIndex{r->var, r->name, offset};
+    }
+
+    // Nothing but the loop's statements can change a variable of this block not escaping
+    static bool isInvariantIn(std::shared_ptr<Variable> var, const std::string &name, std::shared_ptr<AST::Statement> stmt) {
+        return !var->isEscaping && !var->isReference && !checkAssigns(stmt, name);
+    }
+
+    void findLoopPlans(std::shared_ptr<AST::Statement> stmt, size_t &slots) {
+        auto addPlan = [&](const AST::Statement *loop, LoopPlan plan) {
+            if (plan.getSlots() == 0) return;
+            slots = std::max(slots, plan.getSlots());
+            loopPlans[loop] = std::move(plan);
+        };
+        if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) findLoopPlans(sub, slots);
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            findLoopPlans(st->statementForTrue, slots);
+            findLoopPlans(st->statementForFalse, slots);
+        } else if (auto st = std::dynamic_pointer_cast<AST::WhileStatement>(stmt)) {
+            if (containsLoop(st->statement)) return findLoopPlans(st->statement, slots);
+            addPlan(st.get(), planLoop(st->statement, st->condition, ""));
+        } else if (auto st = std::dynamic_pointer_cast<AST::RepeatStatement>(stmt)) {
+            if (containsLoop(st->statement)) return findLoopPlans(st->statement, slots);
+            addPlan(st.get(), planLoop(st->statement, st->condition, ""));
+        } else if (auto st = std::dynamic_pointer_cast<AST::ForStatement>(stmt)) {
+            if (containsLoop(st->statement)) return findLoopPlans(st->statement, slots);
+            auto plan = planLoop(st->statement, nullptr, st->variable);
+            if (options.vectorization) findVectorLoop(plan, st);
+            addPlan(st.get(), std::move(plan));
+        }
+    }
+
+    LoopPlan planLoop(std::shared_ptr<AST::Statement> body, std::shared_ptr<AST::Expression> condition, const std::string &variable) const {
+        LoopPlan plan;
+        LoopScope scope{body, variable, hasHiddenStatementWrites(body) || (condition && hasHiddenWrites(condition))};
+        findInductionPointers(plan, scope, condition);
+        if (options.loopInvariantMotion) {
+            findStatementInvariants(body, scope, plan);
+            if (condition) findInvariants(condition, scope, plan);
+        }
+
+        ssize_t slot = frameSize;
+        for (auto &pointer : plan.pointers) pointer.frameOffset = -++slot;
+        for (auto &invariant : plan.invariants) invariant.frameOffset = -++slot;
+        return plan;
+    }
+
+    void findInductionPointers(LoopPlan &plan, const LoopScope &scope, std::shared_ptr<AST::Expression> condition) const {
+        // The variable of a for loop, if it can step the pointers
+        std::shared_ptr<Variable> var;
+        if (!scope.variable.empty() && options.inductionPointers) {
+            auto [slevel, sym] = findSymbol(scope.variable);
+            var = std::dynamic_pointer_cast<Variable>(sym);
+            if (!var || slevel != level || !std::dynamic_pointer_cast<TypeInteger>(var->type) || !isInvariantIn(var, scope.variable, scope.body))
+                var = nullptr;
+        }
+
+        std::vector<std::shared_ptr<AST::ArrayAccessExpression>> accesses;
+        collectStatementArrayAccesses(scope.body, accesses);
+        if (condition) collectArrayAccesses(condition, accesses);
+
+        // The accesses with the same array and indexes share their pointer
+        using Key = std::pair<std::shared_ptr<Variable>, std::vector<std::pair<std::shared_ptr<Variable>, long long>>>;
+        std::map<Key, size_t> pointers;
+        for (auto access : accesses) {
+            auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(access->array);
+            if (!ex) continue;
+            auto array = std::dynamic_pointer_cast<Variable>(findSymbol(ex->identifier).second);
+            auto type = array ? std::dynamic_pointer_cast<TypeArray>(array->type) : nullptr;
+            if (!type || type->bounds.size() != access->indexes.size()) continue;
+
+            Key key{array, {}};
+            auto bounds = plan.bounds;
+            long long step = 0, stride = type->getSize() / 8;
+            bool reducible = true;
+            size_t i = 0;
+            for (auto index : access->indexes) {
+                auto [min, max] = type->bounds[i++];
+                stride /= (long long)max - min + 1;
+                auto affine = getAffineIndex(index);
+                if (!affine) {
+                    reducible = false;
+                    break;
+                }
+                auto [u, name, offset] = *affine;
+                if (!u) {
+                    reducible = reducible && min <= offset && offset <= max;
+                } else if (u == var || (name != scope.variable && isInvariantIn(u, name, scope.body))) {
+                    if (u == var) step += stride * 8;
+                    auto [it, inserted] = bounds.try_emplace(u, min - offset, max - offset);
+                    it->second = {std::max(it->second.first, min - offset), std::min(it->second.second, max - offset)};
+                    reducible = reducible && it->second.first <= it->second.second;
+                } else reducible = false;
+                key.second.push_back({u, offset});
+            }
+            // The elements at invariant indexes are only hoisted with the loop-invariant code motion
+            if (!reducible || step > INT32_MAX || (step == 0 && !options.loopInvariantMotion)) continue;
+
+            auto [it, inserted] = pointers.try_emplace(key, plan.pointers.size());
+            if (inserted) {
+                plan.pointers.push_back({access, type->memberType, 0, step});
+                plan.bounds = std::move(bounds);
+            }
+            plan.accesses[access.get()] = it->second;
+        }
+    }
+
+    // The lane-wise instruction of an operator on 64-bit lanes, if there is one: SSE2 and AVX2 have
+    // no 64-bit integer multiplication
+    static const char *getVectorInstruction(AST::BinaryOperator op, bool isDouble) {
+        switch (op) {
+            case AST::BinaryOperator::Plus: return isDouble ? "addpd" : "paddq";
+            case AST::BinaryOperator::Minus: return isDouble ? "subpd" : "psubq";
+            case AST::BinaryOperator::Times: return isDouble ? "mulpd" : nullptr;
+            case AST::BinaryOperator::Slash: return isDouble ? "divpd" : nullptr;
+            case AST::BinaryOperator::And: return isDouble ? nullptr : "pand";
+            case AST::BinaryOperator::Or: return isDouble ? nullptr : "por";
+            case AST::BinaryOperator::Xor: return isDouble ? nullptr : "pxor";
+            default: return nullptr;
+        }
+    }
+
+    // Whether a number expression of constants, variables and operators is a double
+    bool isDoubleValue(std::shared_ptr<AST::Expression> expr) const {
+        if (auto literal = constantPropagation.getConstant(expr.get())) return isDoubleType(Constant(*literal).type);
+        if (auto ex = std::dynamic_pointer_cast<AST::ConstantExpression>(expr)) return isDoubleType(Constant(ex->value).type);
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto sym = findSymbol(ex->identifier).second;
+            if (auto cst = std::dynamic_pointer_cast<Constant>(sym)) return isDoubleType(cst->type);
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            return var && isDoubleType(var->type);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            if (ex->op == AST::BinaryOperator::Slash) return true;
+            if (ex->op < AST::BinaryOperator::Plus || ex->op > AST::BinaryOperator::Slash) return false;
+            return isDoubleValue(ex->leftOperand) || isDoubleValue(ex->rightOperand);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            return ex->op != AST::UnaryOperator::Not && isDoubleValue(ex->operand);
+        }
+        return false;
+    }
+
+    // The integer or double type the codegen gives a number expression of constants, variables,
+    // members, elements and operators, leaving SCCP out, or null for any other expression
+    std::shared_ptr<Type> getNumberType(std::shared_ptr<AST::Expression> expr) const {
+        std::shared_ptr<Type> type;
+        if (auto ex = std::dynamic_pointer_cast<AST::ConstantExpression>(expr)) {
+            type = Constant(ex->value).type;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto sym = findSymbol(ex->identifier).second;
+            if (auto cst = std::dynamic_pointer_cast<Constant>(sym)) type = cst->type;
+            else if (auto var = std::dynamic_pointer_cast<Variable>(sym)) type = var->type;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(expr)) {
+            type = getLeftValueType(ex);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            auto left = getNumberType(ex->leftOperand), right = getNumberType(ex->rightOperand);
+            if (!left || !right) return nullptr;
+            if (ex->op < AST::BinaryOperator::Plus || ex->op > AST::BinaryOperator::Slash) return builtinTypeInteger;
+            if (isDoubleType(left) || isDoubleType(right) || ex->op == AST::BinaryOperator::Slash) return builtinTypeDouble;
+            return builtinTypeInteger;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            if (ex->op == AST::UnaryOperator::At) return nullptr;
+            type = getNumberType(ex->operand);
+            if (ex->op == AST::UnaryOperator::Not && isDoubleType(type)) return nullptr;
+        }
+        if (!isDoubleType(type) && !std::dynamic_pointer_cast<TypeInteger>(type)) return nullptr;
+        return type;
+    }
+
+    // The SCCP results are applied by expression, so the IR must type every expression the codegen
+    // knows to be a number the same way, and the ones it folds must be numbers to the codegen
+    void checkExpressionTypes(std::shared_ptr<AST::Expression> expr) const {
+        if (auto it = expressionTypes.find(expr.get()); it != expressionTypes.end()) {
+            auto type = getNumberType(expr);
+            bool isNumber = it->second == IR::Type::Integer || it->second == IR::Type::Double;
+            if (type && isNumber && isDoubleType(type) != (it->second == IR::Type::Double))
+                reportError("Bug! The IR types an expression as {}, but the codegen as {}", IR::getTypeName(it->second), type->getSignature());
+            if (!type && constantPropagation.getConstant(expr.get()))
+                reportError("Bug! The IR folds an expression the codegen doesn't take as a number");
+        }
+
+        if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            checkExpressionTypes(ex->record);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            checkExpressionTypes(ex->array);
+            for (auto index : ex->indexes) checkExpressionTypes(index);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            checkExpressionTypes(ex->pointer);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            checkExpressionTypes(ex->leftOperand);
+            checkExpressionTypes(ex->rightOperand);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            checkExpressionTypes(ex->operand);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            for (auto argument : ex->argumentList) checkExpressionTypes(argument);
+        }
+    }
+
+    void checkStatementTypes(std::shared_ptr<AST::Statement> stmt) const {
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            checkExpressionTypes(st->left);
+            checkExpressionTypes(st->right);
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) checkStatementTypes(sub);
+        } else if (auto st = std::dynamic_pointer_cast<AST::WhileStatement>(stmt)) {
+            checkExpressionTypes(st->condition);
+            checkStatementTypes(st->statement);
+        } else if (auto st = std::dynamic_pointer_cast<AST::RepeatStatement>(stmt)) {
+            checkStatementTypes(st->statement);
+            checkExpressionTypes(st->condition);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ForStatement>(stmt)) {
+            checkExpressionTypes(st->initialValue);
+            checkExpressionTypes(st->finalValue);
+            checkStatementTypes(st->statement);
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            checkExpressionTypes(st->condition);
+            checkStatementTypes(st->statementForTrue);
+            checkStatementTypes(st->statementForFalse);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+            checkExpressionTypes(st->expression);
+        }
+    }
+
+    // Whether an expression of a vector loop can be computed lane by lane, finding the elements to load
+    // as vectors and the invariant operands to broadcast. Counts the vector registers it takes.
+    bool findVectorOperands(std::shared_ptr<AST::Expression> expr, const LoopScope &scope, const LoopPlan &plan, VectorLoop &loop,
+                            std::vector<std::shared_ptr<AST::ArrayAccessExpression>> &loads, size_t &registers) const {
+        registers++;
+        if (getValueCost(expr, &scope)) {
+            // Integers are converted before they're broadcast, as the operators would convert them
+            if (isDoubleValue(expr) && !loop.isDouble) return false;
+            loop.broadcasts.push_back(expr);
+            return true;
+        }
+        if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            auto it = plan.accesses.find(ex.get());
+            if (it == plan.accesses.end()) return false;
+            auto &pointer = plan.pointers[it->second];
+            if (!std::dynamic_pointer_cast<TypeInteger>(pointer.type) && !isDoubleType(pointer.type)) return false;
+            if (isDoubleType(pointer.type) != loop.isDouble || (pointer.step != 0 && pointer.step != 8)) return false;
+            if (pointer.step == 0) loop.broadcasts.push_back(ex);
+            else loads.push_back(ex);
+            return true;
+        }
+        if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            return getVectorInstruction(ex->op, loop.isDouble) &&
+                   findVectorOperands(ex->leftOperand, scope, plan, loop, loads, registers) &&
+                   findVectorOperands(ex->rightOperand, scope, plan, loop, loads, registers);
+        }
+        if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr); ex && ex->op == AST::UnaryOperator::Plus)
+            return findVectorOperands(ex->operand, scope, plan, loop, loads, registers);
+        return false;
+    }
+
+    // Whether storing the elements a vector at a time keeps what the loads of a loop read. A vector
+    // iteration loads before it stores, so no load may read an element an earlier iteration stores.
+    bool isVectorStoreIndependent(const VectorLoop &loop, const std::vector<std::shared_ptr<AST::ArrayAccessExpression>> &loads,
+                                  const std::string &variable) const {
+        auto getArray = [&](std::shared_ptr<AST::ArrayAccessExpression> access) {
+            auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(access->array);
+            return std::dynamic_pointer_cast<Variable>(findSymbol(ex->identifier).second);
+        };
+        // Arrays of numbers are the same or don't overlap
+        auto stored = getArray(loop.store);
+        auto mayAlias = [&](std::shared_ptr<Variable> array) { return array == stored || array->isReference || stored->isReference; };
+
+        for (auto expr : loop.broadcasts)
+            if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr); ex && mayAlias(getArray(ex))) return false;
+        for (auto load : loads) {
+            if (!mayAlias(getArray(load))) continue;
+            if (load->indexes.size() != loop.store->indexes.size()) return false;
+
+            // Loading the element stored, or one after it, unless another index differs
+            bool disjoint = false, later = true;
+            for (auto i = load->indexes.begin(), j = loop.store->indexes.begin(); i != load->indexes.end(); i++, j++) {
+                auto l = *getAffineIndex(*i), s = *getAffineIndex(*j);
+                if (l.name == variable && s.name == variable) later = later && l.offset >= s.offset;
+                else if (l.name == variable || s.name == variable) return false;
+                else if (l.var == s.var && l.offset != s.offset) disjoint = true;
+            }
+            if (!disjoint && !later) return false;
+        }
+        return true;
+    }
+
+    void findVectorLoop(LoopPlan &plan, std::shared_ptr<AST::ForStatement> st) const {
+        if (st->direction != AST::ForStatement::Direction::Up) return;
+        auto stmt = st->statement;
+        while (auto compound = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            std::list<std::shared_ptr<AST::Statement>> statements;
+            for (auto sub : compound->statements)
+                if (!std::dynamic_pointer_cast<AST::EmptyStatement>(sub)) statements.push_back(sub);
+            if (statements.size() != 1) return;
+            stmt = statements.front();
+        }
+        auto assignment = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt);
+        if (!assignment) return;
+
+        VectorLoop loop{assignment->right, false, nullptr, nullptr, false, {}};
+        if (auto lv = std::dynamic_pointer_cast<AST::IdentifierExpression>(assignment->left)) {
+            // s := s + x, s := x + s or s := s - x, as integers wrap around in any order
+            auto [slevel, sym] = findSymbol(lv->identifier);
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(assignment->right);
+            if (!var || slevel != level || lv->identifier == st->variable || !std::dynamic_pointer_cast<TypeInteger>(var->type) ||
+                var->isEscaping || var->isReference || !ex) return;
+            auto isSum = [&](std::shared_ptr<AST::Expression> expr) {
+                auto id = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr);
+                return id && id->identifier == lv->identifier;
+            };
+            if (ex->op == AST::BinaryOperator::Plus && isSum(ex->leftOperand)) loop.value = ex->rightOperand;
+            else if (ex->op == AST::BinaryOperator::Plus && isSum(ex->rightOperand)) loop.value = ex->leftOperand;
+            else if (ex->op == AST::BinaryOperator::Minus && isSum(ex->leftOperand)) loop.value = ex->rightOperand, loop.subtracts = true;
+            else return;
+            loop.sum = var;
+        } else if (auto lv = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(assignment->left)) {
+            auto it = plan.accesses.find(lv.get());
+            if (it == plan.accesses.end() || plan.pointers[it->second].step != 8) return;
+            auto type = plan.pointers[it->second].type;
+            if (!std::dynamic_pointer_cast<TypeInteger>(type) && !isDoubleType(type)) return;
+            loop.isDouble = isDoubleType(type);
+            loop.store = lv;
+        } else return;
+
+        LoopScope scope{st->statement, st->variable, hasHiddenStatementWrites(st->statement)};
+        std::vector<std::shared_ptr<AST::ArrayAccessExpression>> loads;
+        size_t registers = loop.sum ? 2 : 0; // With the one adding up the lanes
+        if (!findVectorOperands(loop.value, scope, plan, loop, loads, registers) || registers > REG_DOUBLE_TEMPORARIES.size()) return;
+        if (loop.sum ? loads.empty() : !isVectorStoreIndependent(loop, loads, st->variable)) return;
+        plan.vectorLoop = std::move(loop);
+    }
+
+    bool hasHiddenWrites(std::shared_ptr<AST::Expression> expr) const {
+        // The functions whose calls can be expanded inline only read
+        auto hasSideEffects = [](std::shared_ptr<Function> func) {
+            return !func->isBuiltinFunction && !func->inlineBody;
+        };
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto func = std::dynamic_pointer_cast<Function>(findSymbol(ex->identifier).second);
+            return func && hasSideEffects(func);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            return hasHiddenWrites(ex->record);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            if (hasHiddenWrites(ex->array)) return true;
+            for (auto index : ex->indexes) if (hasHiddenWrites(index)) return true;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            return hasHiddenWrites(ex->pointer);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            return hasHiddenWrites(ex->leftOperand) || hasHiddenWrites(ex->rightOperand);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            return hasHiddenWrites(ex->operand);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            auto func = std::dynamic_pointer_cast<Function>(findSymbol(ex->functionName).second);
+            if (!func || hasSideEffects(func)) return true;
+            // Arguments bound to references may be written through
+            for (auto [name, byReference, type] : func->parameters) if (byReference) return true;
+            for (auto argument : ex->argumentList) if (hasHiddenWrites(argument)) return true;
+        }
+        return false;
+    }
+
+    bool hasHiddenStatementWrites(std::shared_ptr<AST::Statement> stmt) const {
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            // Writing a variable by its name, or one of its members or elements, is seen by checkAssigns()
+            std::shared_ptr<AST::Expression> left = st->left;
+            while (true) {
+                if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(left)) left = ex->record;
+                else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(left)) left = ex->array;
+                else break;
+            }
+            auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(left);
+            auto var = ex ? std::dynamic_pointer_cast<Variable>(findSymbol(ex->identifier).second) : nullptr;
+            if (!ex || (var && var->isReference)) return true;
+            return hasHiddenWrites(st->left) || hasHiddenWrites(st->right);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExplicitCallStatement>(stmt)) {
+            return hasHiddenWrites(std::make_shared<AST::IdentifierExpression>(st->functionName));
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) if (hasHiddenStatementWrites(sub)) return true;
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            return hasHiddenWrites(st->condition) || hasHiddenStatementWrites(st->statementForTrue) || hasHiddenStatementWrites(st->statementForFalse);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+            return hasHiddenWrites(st->expression);
+        } else if (stmt && !std::dynamic_pointer_cast<AST::EmptyStatement>(stmt)) {
+            return true;
+        }
+        return false;
+    }
+
+    bool isLoopInvariant(std::shared_ptr<Variable> var, const std::string &name, size_t slevel, const LoopScope &scope) const {
+        if (name == scope.variable || var->isReference || checkAssigns(scope.body, name)) return false;
+        return (slevel == level && !var->isEscaping) || !scope.hasHiddenWrites;
+    }
+
+    // The instructions evaluating a number expression takes. Given a loop, only if it's invariant in
+    // the loop and can't trap, so it can be evaluated before the loop even if the loop doesn't.
+    std::optional<size_t> getValueCost(std::shared_ptr<AST::Expression> expr, const LoopScope *scope = nullptr) const {
+        auto getConstantCost = [](const std::string &literal) -> std::optional<size_t> {
+            if (Constant(literal).type == builtinTypeString) return std::nullopt;
+            return 0;
+        };
+        if (auto literal = constantPropagation.getConstant(expr.get())) return getConstantCost(*literal);
+        if (auto ex = std::dynamic_pointer_cast<AST::ConstantExpression>(expr)) return getConstantCost(ex->value);
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto [slevel, sym] = findSymbol(ex->identifier);
+            if (auto cst = std::dynamic_pointer_cast<Constant>(sym)) return getConstantCost(cst->literalValue);
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (!var || (!std::dynamic_pointer_cast<TypeInteger>(var->type) && !isDoubleType(var->type))) return std::nullopt;
+            if (scope && !isLoopInvariant(var, ex->identifier, slevel, *scope)) return std::nullopt;
+            if (var->isPromoted()) return 0;
+            if (var->isStatic() || slevel == level) return 1 + var->isReference;
+            // Reaching the frame
+            return (options.nonLocalAccess == NonLocalAccess::Display ? 2 : 1 + level - slevel) + var->isReference;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            if (scope && (ex->op == AST::BinaryOperator::Div || ex->op == AST::BinaryOperator::Mod)) {
+                auto divisor = getImmediate(ex->rightOperand);
+                if (!divisor || *divisor == 0 || *divisor == -1) return std::nullopt;
+            }
+            auto l = getValueCost(ex->leftOperand, scope), r = getValueCost(ex->rightOperand, scope);
+            if (!l || !r) return std::nullopt;
+            return 1 + *l + *r;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            if (ex->op == AST::UnaryOperator::At) return std::nullopt;
+            auto cost = getValueCost(ex->operand, scope);
+            if (!cost) return std::nullopt;
+            return 1 + *cost;
+        }
+        return std::nullopt;
+    }
+
+    // The largest invariant subexpressions costing more than loading them from the frame
+    void findInvariants(std::shared_ptr<AST::Expression> expr, const LoopScope &scope, LoopPlan &plan) const {
+        if (auto cost = getValueCost(expr, &scope)) {
+            if (*cost < 2) return;
+            plan.invariantIndexes[expr.get()] = plan.invariants.size();
+            plan.invariants.push_back({expr, 0, nullptr});
+        } else if (auto ex = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(expr)) {
+            findLeftValueInvariants(ex, scope, plan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            findInvariants(ex->leftOperand, scope, plan);
+            findInvariants(ex->rightOperand, scope, plan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            if (auto le = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(ex->operand); le && ex->op == AST::UnaryOperator::At)
+                findLeftValueInvariants(le, scope, plan);
+            else
+                findInvariants(ex->operand, scope, plan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            auto func = std::dynamic_pointer_cast<Function>(findSymbol(ex->functionName).second);
+            size_t i = 0;
+            for (auto argument : ex->argumentList) {
+                auto le = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(argument);
+                if (le && func && i < func->parameters.size() && std::get<1>(func->parameters[i])) findLeftValueInvariants(le, scope, plan);
+                else findInvariants(argument, scope, plan);
+                i++;
+            }
+        }
+    }
+
+    void findLeftValueInvariants(std::shared_ptr<AST::MaybeLeftValueExpression> expr, const LoopScope &scope, LoopPlan &plan) const {
+        if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            findLeftValueInvariants(ex->record, scope, plan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            // Not evaluated when reached through a pointer
+            if (plan.accesses.count(ex.get())) return;
+            findLeftValueInvariants(ex->array, scope, plan);
+            for (auto index : ex->indexes) findInvariants(index, scope, plan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            findInvariants(ex->pointer, scope, plan);
+        }
+    }
+
+    void findStatementInvariants(std::shared_ptr<AST::Statement> stmt, const LoopScope &scope, LoopPlan &plan) const {
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            findLeftValueInvariants(st->left, scope, plan);
+            findInvariants(st->right, scope, plan);
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) findStatementInvariants(sub, scope, plan);
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            findInvariants(st->condition, scope, plan);
+            findStatementInvariants(st->statementForTrue, scope, plan);
+            findStatementInvariants(st->statementForFalse, scope, plan);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+            findInvariants(st->expression, scope, plan);
+        }
+    }
+
+    // A key identifying the value of a number expression by its structure, and the variables it reads
+    std::optional<std::string> getValueKey(std::shared_ptr<AST::Expression> expr, std::set<std::string> &variables) const {
+        if (auto ex = std::dynamic_pointer_cast<AST::ConstantExpression>(expr)) {
+            if (Constant(ex->value).type == builtinTypeString) return std::nullopt;
+            return "#" + ex->value;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto sym = findSymbol(ex->identifier).second;
+            if (auto cst = std::dynamic_pointer_cast<Constant>(sym)) {
+                if (cst->type == builtinTypeString) return std::nullopt;
+                return "#" + cst->literalValue;
+            }
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (!var || (!std::dynamic_pointer_cast<TypeInteger>(var->type) && !isDoubleType(var->type))) return std::nullopt;
+            variables.insert(ex->identifier);
+            return ex->identifier;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            auto l = getValueKey(ex->leftOperand, variables), r = getValueKey(ex->rightOperand, variables);
+            if (!l || !r) return std::nullopt;
+            return fmt::format("({} {} {})", *l, AST::getBinaryOperatorName(ex->op), *r);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            if (ex->op == AST::UnaryOperator::At) return std::nullopt;
+            auto operand = getValueKey(ex->operand, variables);
+            if (!operand) return std::nullopt;
+            return fmt::format("{}({})", AST::getUnaryOperatorName(ex->op), *operand);
+        }
+        return std::nullopt;
+    }
+
+    // The same for the address of an element of an array variable
+    std::optional<std::string> getAddressKey(std::shared_ptr<AST::ArrayAccessExpression> expr, std::set<std::string> &variables) const {
+        auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr->array);
+        if (!ex) return std::nullopt;
+        auto var = std::dynamic_pointer_cast<Variable>(findSymbol(ex->identifier).second);
+        if (!var || !std::dynamic_pointer_cast<TypeArray>(var->type)) return std::nullopt;
+        std::string indexes;
+        for (auto index : expr->indexes) {
+            auto indexKey = getValueKey(index, variables);
+            if (!indexKey) return std::nullopt;
+            indexes += (indexes.empty() ? "" : ", ") + *indexKey;
+        }
+        return fmt::format("&{}[{}]", ex->identifier, indexes);
+    }
+
+    bool isLocalValue(const std::set<std::string> &variables) const {
+        for (auto name : variables) {
+            auto [slevel, sym] = findSymbol(name);
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (!var || slevel != level || var->isEscaping || var->isReference) return false;
+        }
+        return true;
+    }
+
+    // Forget the values reading a variable assigned by its name, or without one, all but the local
+    // ones, on a store through a pointer or reference, or a call
+    static void forgetValues(std::map<std::string, SavedValue> &values, std::optional<std::string> name) {
+        for (auto it = values.begin(); it != values.end(); ) {
+            if (name ? it->second.variables.count(*name) : !it->second.isLocal) it = values.erase(it);
+            else it++;
+        }
+    }
+
+    void forgetAssignedValues(std::map<std::string, SavedValue> &values, std::shared_ptr<AST::MaybeLeftValueExpression> left) const {
+        std::shared_ptr<AST::Expression> root = left;
+        while (true) {
+            if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(root)) root = ex->record;
+            else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(root)) root = ex->array;
+            else break;
+        }
+        auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(root);
+        auto [slevel, sym] = ex ? findSymbol(ex->identifier) : std::make_pair(level, std::shared_ptr<Symbol>());
+        auto var = std::dynamic_pointer_cast<Variable>(sym);
+        if (ex) forgetValues(values, ex->identifier);
+        if (!ex || (var && var->isReference)) forgetValues(values, std::nullopt);
+        // A reference parameter may be bound to a global, an escaping local or any element
+        else if (var && (var->isEscaping || slevel != level || root != left)) forgetReferenceValues(values);
+    }
+
+    void forgetReferenceValues(std::map<std::string, SavedValue> &values) const {
+        for (auto it = values.begin(); it != values.end(); ) {
+            bool readsReference = false;
+            for (auto name : it->second.variables) {
+                auto var = std::dynamic_pointer_cast<Variable>(findSymbol(name).second);
+                if (var && var->isReference) readsReference = true;
+            }
+            if (readsReference) it = values.erase(it);
+            else it++;
+        }
+    }
+
+    // The values and addresses available along a run as it would be generated, and the ones
+    // computed again
+    struct ValueScan {
+        const LoopPlan *loopPlan; // Whose body the run is in
+        std::map<std::string, SavedValue> available;
+        std::set<std::string> repeated;
+    };
+
+    void scanValues(std::shared_ptr<AST::Expression> expr, ValueScan &scan) const {
+        if (constantPropagation.getConstant(expr.get())) return;
+        if (scan.loopPlan && scan.loopPlan->invariantIndexes.count(expr.get())) return;
+        std::set<std::string> variables;
+        auto key = getValueKey(expr, variables);
+        if (auto cost = getValueCost(expr); !cost || *cost < 2) key = std::nullopt;
+        if (key && scan.available.count(*key)) {
+            scan.repeated.insert(*key);
+            return;
+        }
+
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            if (std::dynamic_pointer_cast<Function>(findSymbol(ex->identifier).second) && hasHiddenWrites(ex))
+                forgetValues(scan.available, std::nullopt);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(expr)) {
+            scanLeftValues(ex, scan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            scanValues(ex->leftOperand, scan);
+            scanValues(ex->rightOperand, scan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            if (auto le = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(ex->operand); le && ex->op == AST::UnaryOperator::At)
+                scanLeftValues(le, scan);
+            else
+                scanValues(ex->operand, scan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            auto func = std::dynamic_pointer_cast<Function>(findSymbol(ex->functionName).second);
+            size_t i = 0;
+            for (auto argument : ex->argumentList) {
+                auto le = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(argument);
+                if (le && func && i < func->parameters.size() && std::get<1>(func->parameters[i])) scanLeftValues(le, scan);
+                else scanValues(argument, scan);
+                i++;
+            }
+            if (hasHiddenWrites(ex)) forgetValues(scan.available, std::nullopt);
+        }
+        if (key) scan.available[*key] = {0, nullptr, variables, isLocalValue(variables)};
+    }
+
+    void scanLeftValues(std::shared_ptr<AST::MaybeLeftValueExpression> expr, ValueScan &scan) const {
+        if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            scanLeftValues(ex->record, scan);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            // Not evaluated when reached through a pointer
+            if (scan.loopPlan && scan.loopPlan->accesses.count(ex.get())) return;
+            std::set<std::string> variables;
+            auto key = getAddressKey(ex, variables);
+            if (key && scan.available.count(*key)) {
+                scan.repeated.insert(*key);
+                return;
+            }
+            for (auto it = ex->indexes.rbegin(); it != ex->indexes.rend(); it++) scanValues(*it, scan);
+            scanLeftValues(ex->array, scan);
+            if (key) scan.available[*key] = {0, nullptr, variables, isLocalValue(variables)};
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            scanValues(ex->pointer, scan);
+        }
+    }
+
+    bool isStraightLine(std::shared_ptr<AST::Statement> stmt) const {
+        return (std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt) || std::dynamic_pointer_cast<AST::ExplicitCallStatement>(stmt) ||
+                std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) && !tailCalls.count(stmt.get());
+    }
+
+    void addStraightLine(const std::vector<std::shared_ptr<AST::Statement>> &run, const LoopPlan *loopPlan, size_t &slots) {
+        ValueScan scan{loopPlan, {}, {}};
+        for (auto stmt : run) {
+            if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+                scanValues(st->right, scan);
+                scanLeftValues(st->left, scan);
+                forgetAssignedValues(scan.available, st->left);
+            } else if (auto st = std::dynamic_pointer_cast<AST::ExplicitCallStatement>(stmt)) {
+                if (hasHiddenWrites(std::make_shared<AST::IdentifierExpression>(st->functionName)))
+                    forgetValues(scan.available, std::nullopt);
+            } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+                scanValues(st->expression, scan);
+            }
+        }
+        if (scan.repeated.empty()) return;
+
+        std::map<std::string, ssize_t> runSlots;
+        for (auto key : scan.repeated) runSlots[key] = -(ssize_t)(frameSize + runSlots.size() + 1);
+        slots = std::max(slots, runSlots.size());
+        for (size_t i = 0; i < run.size(); i++) straightLinePositions[run[i].get()] = {valueSlots.size(), i};
+        valueSlots.push_back(std::move(runSlots));
+    }
+
+    void findRepeatedValues(std::shared_ptr<AST::Statement> stmt, const LoopPlan *loopPlan, size_t &slots) {
+        if (isStraightLine(stmt)) {
+            addStraightLine({stmt}, loopPlan, slots);
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            std::vector<std::shared_ptr<AST::Statement>> run;
+            for (auto sub : st->statements) {
+                if (isStraightLine(sub)) {
+                    run.push_back(sub);
+                    continue;
+                }
+                addStraightLine(run, loopPlan, slots);
+                run.clear();
+                findRepeatedValues(sub, loopPlan, slots);
+            }
+            addStraightLine(run, loopPlan, slots);
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            findRepeatedValues(st->statementForTrue, loopPlan, slots);
+            findRepeatedValues(st->statementForFalse, loopPlan, slots);
+        } else if (auto st = std::dynamic_pointer_cast<AST::WhileStatement>(stmt)) {
+            findRepeatedValues(st->statement, getLoopPlan(st.get()), slots);
+        } else if (auto st = std::dynamic_pointer_cast<AST::RepeatStatement>(stmt)) {
+            findRepeatedValues(st->statement, getLoopPlan(st.get()), slots);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ForStatement>(stmt)) {
+            findRepeatedValues(st->statement, getLoopPlan(st.get()), slots);
+        }
+    }
+
+    const LoopPlan *getLoopPlan(const AST::Statement *loop) const {
+        auto it = loopPlans.find(loop);
+        return it == loopPlans.end() ? nullptr : &it->second;
+    }
+
+    // The variable of the i-th parameter
+    std::shared_ptr<Variable> getParameter(size_t i) const {
+        return std::dynamic_pointer_cast<Variable>(symbolTable.at(std::get<0>(function->parameters[i])));
+    }
+
+    // Put a parameter passed in a register where it's kept
+    void generateParameterStore(AssemblyContext &ctx, size_t i, const std::string &reg) {
+        auto var = getParameter(i);
+        if (var->isPromoted())
+            generateMove(ctx, var->reg, reg);
+        else
+            ctx.generate("{} {}, {}", getMoveInstruction(reg), getMemoryOperand("rbp", var->frameOffset * 8), reg);
+    }
+
+    // Give the parameters passed in registers which stay in memory their slots
+    void allocateParameterSlots() {
+        for (size_t i = 0; i < function->argumentRegisters.size(); i++) {
+            auto var = getParameter(i);
+            if (var->frameOffset == 0 && !var->isPromoted()) var->frameOffset = -(ssize_t)++frameSize;
+        }
+    }
+
+    // Zero the slots of the local variables kept in the frame, one by one if there are few,
+    // otherwise the whole area with a single string store
+    void generateZeroFill() {
+        std::vector<ssize_t> slots;
+        for (auto [name, var] : frame.variables) {
+            if (var->isPromoted() || var->isStatic()) continue;
+            for (size_t i = 0; i < var->type->getSize() / 8; i++) slots.push_back(var->frameOffset + i);
+        }
+
+        if (slots.size() <= BULK_UNROLL_LIMIT) {
+            for (auto slot : slots) ctx.generate("mov {}, 0", getMemoryOperand("rbp", slot * 8));
+            return;
+        }
+        // The variables come first, below them are the slots written before they're read
+        auto lowest = *std::min_element(slots.begin(), slots.end());
+        ctx.generate("lea rdi, {}", getMemoryOperand("rbp", lowest * 8));
+        ctx.generate("mov rcx, {}", -lowest);
+        ctx.generate("xor rax, rax");
+        ctx.generate("rep stosq");
+    }
+
+    // A variable bound to a reference or whose address is taken can't live in a register
+    void markEscaping(std::shared_ptr<AST::Expression> expr) {
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto [slevel, sym] = resolveSymbol(ex->identifier);
+            if (auto var = std::dynamic_pointer_cast<Variable>(sym)) var->isEscaping = true;
+        }
+    }
+
+    // Keep the most used non-escaping scalar variables in callee-saved registers
+    void promoteVariables(std::shared_ptr<AST::Block> astBlock) {
+        std::map<std::shared_ptr<Variable>, size_t> uses;
+        analyzeStatement(astBlock->statement, uses, 1);
+
+        std::vector<std::pair<size_t, std::shared_ptr<Variable>>> candidates;
+        for (auto [name, sym] : symbolTable) {
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (!var || var->isEscaping || var->isReference) continue;
+            size_t count = uses[var];
+            if (!std::dynamic_pointer_cast<TypeInteger>(var->type) && !isDoubleType(var->type)) continue;
+            // Saving and restoring the register (and loading a parameter) must pay off
+            if (count <= (var->frameOffset > 0 ? 3 : 2)) continue;
+            candidates.push_back({count, var});
+        }
+        std::stable_sort(candidates.begin(), candidates.end(), [](auto &a, auto &b) { return a.first > b.first; });
+
+        size_t usedRegisters = 0, usedDoubleRegisters = 0;
+        for (auto [count, var] : candidates) {
+            if (isDoubleType(var->type)) {
+                if (usedDoubleRegisters == REG_DOUBLE_VARIABLES.size()) continue;
+                var->reg = REG_DOUBLE_VARIABLES[usedDoubleRegisters++];
+            } else {
+                if (usedRegisters == REG_VARIABLES.size()) continue;
+                var->reg = REG_VARIABLES[usedRegisters++];
+            }
+            savedRegisters.push_back(var->reg);
+        }
+    }
+
+    std::shared_ptr<Type> resolveAstType(std::shared_ptr<AST::Type> astType) {
+        if (auto astRecordType = std::dynamic_pointer_cast<AST::RecordType>(astType)) {
+            std::map<std::string, std::shared_ptr<Variable>> variables;
+            size_t size = 0;
+            for (auto astVariable : astRecordType->variables) {
+                if (variables.find(astVariable->name) != variables.end()) {
                     reportError("Duplicated variable name in record: {}", astVariable->name);
                 }
-                variables[astVariable->name] = std::make_shared<Variable>(resolveAstType(astVariable->type), i++);
+                auto type = resolveAstType(astVariable->type);
+                variables[astVariable->name] = std::make_shared<Variable>(type, size / 8);
+                size += type->getSize();
             }
-            return std::make_shared<TypeRecord>(variables);
+            return std::make_shared<TypeRecord>(variables, size);
         } else if (auto astTypeIdentifier = std::dynamic_pointer_cast<AST::TypeIdentifier>(astType)) {
             return resolveTypeName(astTypeIdentifier->name);
         } else if (auto astArraySchema = std::dynamic_pointer_cast<AST::ArraySchema>(astType)) {
@@ -738,19 +2515,114 @@ public:
 
     // [level, symbol]
     std::pair<size_t, std::shared_ptr<Symbol>> resolveSymbol(const std::string &symbolName) const {
+        return (inlineScope ? inlineScope : this)->resolveSymbolInScope(symbolName);
+    }
+
+    std::pair<size_t, std::shared_ptr<Symbol>> resolveSymbolInScope(const std::string &symbolName) const {
         if (function && symbolName == function->name) return {level - 1, function};
         if (auto it = symbolTable.find(symbolName); it != symbolTable.end()) return {level, it->second};
-        if (parentBlock) return parentBlock->resolveSymbol(symbolName);
+        if (parentBlock) return parentBlock->resolveSymbolInScope(symbolName);
         reportError("Can't resolve symbol: {}", symbolName);
     }
 
+    // Variables accessed from nested blocks must stay in the frame
+    void markAccess(size_t slevel, std::shared_ptr<Variable> var) {
+        if (slevel != level) var->isEscaping = true;
+    }
+
+    std::shared_ptr<Variable> getPromotedVariable(std::shared_ptr<AST::MaybeLeftValueExpression> expr) {
+        auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr);
+        if (!ex) return nullptr;
+        auto [slevel, sym] = resolveSymbol(ex->identifier);
+        auto var = std::dynamic_pointer_cast<Variable>(sym);
+        return var && var->isPromoted() ? var : nullptr;
+    }
+
     void loadFrame(AssemblyContext &ctx, size_t level) {
+        if (frameBaseLevel == level) return;
+
         if (level == this->level) {
             ctx.generate("mov {}, rbp", REG_FRAME_BASE);
+        } else if (options.nonLocalAccess == NonLocalAccess::Display) {
+            ctx.generate("mov {}, {}", REG_FRAME_BASE, getDisplayOperand(level));
         } else {
-            ctx.generate("mov rax, {}", this->level + this->function->parameters.size() + 1 - level);
-            ctx.generate("mov {}, qword ptr [rbp + rax * 8]", REG_FRAME_BASE);
+            // Follow the static links, starting from the nearest frame already in hand
+            const Block *block = this;
+            std::string base = "rbp";
+            if (frameBaseLevel && *frameBaseLevel > level && *frameBaseLevel < this->level) {
+                while (block->level != *frameBaseLevel) block = block->parentBlock;
+                base = REG_FRAME_BASE;
+            }
+            for (; block->level != level; block = block->parentBlock) {
+                ctx.generate("mov {}, {}", REG_FRAME_BASE, getMemoryOperand(base, block->getStaticLinkOffset()));
+                base = REG_FRAME_BASE;
+            }
         }
+        frameBaseLevel = level;
+    }
+
+    // The static link is pushed right before the arguments
+    ssize_t getStaticLinkOffset() const {
+        return (function->getStackArguments() + 2) * 8;
+    }
+
+    static std::string getDisplayOperand(size_t level) {
+        return level == 0 ? "qword ptr .Display[rip]" : fmt::format("qword ptr .Display[rip + {}]", level * 8);
+    }
+
+    void loadVariableFrame(AssemblyContext &ctx, size_t level, std::shared_ptr<Variable> var) {
+        if (!var->isStatic()) loadFrame(ctx, level);
+    }
+
+    // At jump targets and after REG_FRAME_BASE is repointed
+    void forgetFrameBase() {
+        frameBaseLevel.reset();
+    }
+
+    // The range of values an integer expression is known to take
+    std::optional<std::pair<long long, long long>> getRange(std::shared_ptr<AST::Expression> expr) const {
+        auto getConstantRange = [](const std::string &literal) -> std::optional<std::pair<long long, long long>> {
+            auto value = AST::ConstantFolder::parseLiteral(literal);
+            if (!value || value->isDouble) return std::nullopt;
+            return std::make_pair(value->integer, value->integer);
+        };
+
+        if (auto literal = constantPropagation.getConstant(expr.get())) return getConstantRange(*literal);
+        if (auto ex = std::dynamic_pointer_cast<AST::ConstantExpression>(expr)) return getConstantRange(ex->value);
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto [slevel, sym] = resolveSymbol(ex->identifier);
+            if (auto cst = std::dynamic_pointer_cast<Constant>(sym)) return getConstantRange(cst->literalValue);
+            auto var = std::dynamic_pointer_cast<Variable>(sym);
+            if (auto it = loopRanges.find(var); var && it != loopRanges.end()) return it->second;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            if (ex->op != AST::BinaryOperator::Plus && ex->op != AST::BinaryOperator::Minus) return std::nullopt;
+            auto l = getRange(ex->leftOperand), r = getRange(ex->rightOperand);
+            // Far from overflowing
+            const long long LIMIT = 1LL << 60;
+            if (!l || !r || l->first < -LIMIT || l->second > LIMIT || r->first < -LIMIT || r->second > LIMIT) return std::nullopt;
+            if (ex->op == AST::BinaryOperator::Plus) return std::make_pair(l->first + r->first, l->second + r->second);
+            return std::make_pair(l->first - r->second, l->second - r->first);
+        }
+        return std::nullopt;
+    }
+
+    // Whether a statement may assign a variable by its name
+    static bool checkAssigns(std::shared_ptr<AST::Statement> stmt, const std::string &name) {
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            auto lv = std::dynamic_pointer_cast<AST::IdentifierExpression>(st->left);
+            return lv && lv->identifier == name;
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) if (checkAssigns(sub, name)) return true;
+        } else if (auto st = std::dynamic_pointer_cast<AST::WhileStatement>(stmt)) {
+            return checkAssigns(st->statement, name);
+        } else if (auto st = std::dynamic_pointer_cast<AST::RepeatStatement>(stmt)) {
+            return checkAssigns(st->statement, name);
+        } else if (auto st = std::dynamic_pointer_cast<AST::ForStatement>(stmt)) {
+            return st->variable == name || checkAssigns(st->statement, name);
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            return checkAssigns(st->statementForTrue, name) || checkAssigns(st->statementForFalse, name);
+        }
+        return false;
     }
 
     static bool checkNumberTypeIsDouble(std::shared_ptr<Type> type) {
@@ -759,18 +2631,19 @@ public:
         reportError("Expected a number type but got: {}", type->getSignature());
     }
 
-    void ensureType(AssemblyContext &ctx, std::shared_ptr<Type> originalType, std::shared_ptr<Type> targetType) {
+    // Convert the depth-th temporary from the top
+    void ensureType(AssemblyContext &ctx, std::shared_ptr<Type> originalType, std::shared_ptr<Type> targetType, size_t depth = 0) {
         if (auto target = std::dynamic_pointer_cast<TypeInteger>(targetType)) {
             if (checkNumberTypeIsDouble(originalType)) {
                 // Convert double to integer
-                ctx.generate("cvttsd2si rax, qword ptr [rsp]");
-                ctx.generate("mov qword ptr [rsp], rax");
+                auto [from, to] = temporaries.convert(ctx, depth, false);
+                ctx.generate("cvttsd2si {}, {}", to, from);
             }
         } else if (auto target = std::dynamic_pointer_cast<TypeDouble>(targetType)) {
             if (!checkNumberTypeIsDouble(originalType)) {
                 // Convert integer to double
-                ctx.generate("cvtsi2sd xmm0, qword ptr [rsp]");
-                ctx.generate("movsd qword ptr [rsp], xmm0");
+                auto [from, to] = temporaries.convert(ctx, depth, true);
+                ctx.generate("cvtsi2sd {}, {}", to, from);
             }
         } else {
             if (*originalType != *targetType)
@@ -778,6 +2651,136 @@ public:
         }
     }
 
+    // Integer literals fitting in 32 bits are encoded in the instruction instead of loaded into a register
+    static std::optional<int32_t> getImmediate(std::shared_ptr<AST::Expression> expr) {
+        if (auto literal = constantPropagation.getConstant(expr.get())) return Constant(*literal).getImmediate();
+        auto ex = std::dynamic_pointer_cast<AST::ConstantExpression>(expr);
+        if (!ex) return std::nullopt;
+        return Constant(ex->value).getImmediate();
+    }
+
+    // The branch a condition always takes, if it's a known integer
+    static std::optional<bool> getKnownCondition(std::shared_ptr<AST::Expression> condition) {
+        auto literal = constantPropagation.getConstant(condition.get());
+        if (!literal) return std::nullopt;
+        auto constant = Constant(*literal);
+        if (!std::dynamic_pointer_cast<TypeInteger>(constant.type)) return std::nullopt;
+        return std::stoll(*literal) != 0;
+    }
+
+    static const char *getSetInstruction(AST::BinaryOperator op) {
+        switch (op) {
+            case AST::BinaryOperator::Equal: return "sete";
+            case AST::BinaryOperator::NotEqual: return "setne";
+            case AST::BinaryOperator::LessThan: return "setl";
+            case AST::BinaryOperator::GreaterThan: return "setg";
+            case AST::BinaryOperator::LessThanOrEqual: return "setle";
+            case AST::BinaryOperator::GreaterThanOrEqual: return "setge";
+            default: reportError("Bug!");
+        }
+    }
+
+    // Multiply a register by a constant, with lea and shifts where they're cheaper than imul
+    static void generateMultiplication(AssemblyContext &ctx, const std::string &reg, int32_t factor) {
+        if (!options.strengthReduction) {
+            ctx.generate("imul {}, {}, {}", reg, reg, factor);
+            return;
+        }
+
+        // factor = (1, 3, 5 or 9) << shift
+        int shift = 0;
+        int64_t odd = factor;
+        while (odd > 0 && odd % 2 == 0) odd /= 2, shift++;
+
+        if (factor == 0)
+            ctx.generate("xor {}, {}", reg, reg);
+        else if (factor == -1)
+            ctx.generate("neg {}", reg);
+        else if (odd == 3 || odd == 5 || odd == 9)
+            ctx.generate("lea {}, qword ptr [{} + {} * {}]", reg, reg, reg, odd - 1);
+        else if (odd != 1) {
+            ctx.generate("imul {}, {}, {}", reg, reg, factor);
+            return;
+        }
+
+        if (shift == 1)
+            ctx.generate("add {}, {}", reg, reg);
+        else if (shift)
+            ctx.generate("shl {}, {}", reg, shift);
+    }
+
+    // The multiplier and shift of the multiply-high which divides by a constant other than 0, 1, -1
+    // and powers of two, rounding toward negative infinity (Hacker's Delight, 10-1)
+    static std::pair<int64_t, int> getDivisionMagic(int64_t divisor) {
+        const uint64_t TWO63 = 1ULL << 63;
+        uint64_t ad = divisor < 0 ? -(uint64_t)divisor : divisor;
+        uint64_t t = TWO63 + ((uint64_t)divisor >> 63);
+        uint64_t anc = t - 1 - t % ad;
+        int p = 63;
+        uint64_t q1 = TWO63 / anc, r1 = TWO63 - q1 * anc, q2 = TWO63 / ad, r2 = TWO63 - q2 * ad, delta;
+        do {
+            p++;
+            q1 *= 2, r1 *= 2;
+            if (r1 >= anc) q1++, r1 -= anc;
+            q2 *= 2, r2 *= 2;
+            if (r2 >= ad) q2++, r2 -= ad;
+            delta = ad - r2;
+        } while (q1 < delta || (q1 == delta && r1 == 0));
+
+        int64_t magic = (int64_t)(q2 + 1);
+        return {divisor < 0 ? -magic : magic, p - 64};
+    }
+
+    // Divide a register by a constant other than 0 and -1 (which keep their fault), or take the
+    // remainder, without idiv. Both truncate toward zero, so negative dividends are rounded up by
+    // adding the sign bit(s) unless the dividend is known to be non-negative.
+    static void generateDivision(AssemblyContext &ctx, const std::string &reg, int32_t divisor, bool isMod, bool nonNegative) {
+        uint64_t ad = divisor < 0 ? -(int64_t)divisor : divisor;
+        if (ad == 1) {
+            if (isMod) ctx.generate("xor {}, {}", reg, reg);
+            return;
+        }
+
+        if ((ad & (ad - 1)) == 0) {
+            int shift = __builtin_ctzll(ad);
+            // rax = ad - 1 if the dividend is negative, else 0
+            if (!nonNegative) {
+                ctx.generate("mov rax, {}", reg);
+                if (shift > 1) ctx.generate("sar rax, 63");
+                ctx.generate("shr rax, {}", 64 - shift);
+                ctx.generate("add {}, rax", reg);
+            }
+            if (isMod) {
+                // The remainder takes the sign of the dividend only, the divisor's doesn't matter
+                ctx.generate("and {}, {}", reg, ad - 1);
+                if (!nonNegative) ctx.generate("sub {}, rax", reg);
+            } else {
+                ctx.generate("sar {}, {}", reg, shift);
+                if (divisor < 0) ctx.generate("neg {}", reg);
+            }
+            return;
+        }
+
+        auto [magic, shift] = getDivisionMagic(divisor);
+        ctx.generate("mov rax, {}", magic);
+        ctx.generate("imul {}", reg);
+        if (divisor > 0 && magic < 0) ctx.generate("add rdx, {}", reg);
+        if (divisor < 0 && magic > 0) ctx.generate("sub rdx, {}", reg);
+        if (shift) ctx.generate("sar rdx, {}", shift);
+        // Round a negative quotient up
+        if (!nonNegative || divisor < 0) {
+            ctx.generate("mov rax, rdx");
+            ctx.generate("shr rax, 63");
+            ctx.generate("add rdx, rax");
+        }
+
+        if (isMod) {
+            ctx.generate("imul rdx, rdx, {}", divisor);
+            ctx.generate("sub {}, rdx", reg);
+        } else
+            ctx.generate("mov {}, rdx", reg);
+    }
+
     std::shared_ptr<Type> generateBinaryExpression(
         AssemblyContext &ctx,
         std::shared_ptr<AST::Expression> left,
@@ -796,91 +2799,100 @@ public:
             case AST::BinaryOperator::Times:
             case AST::BinaryOperator::Slash: {
                 // Arithmetic operators: int op double = double
+                // Constants go to the right, where they can be immediates
+                if ((op == AST::BinaryOperator::Plus || op == AST::BinaryOperator::Times) && getImmediate(left) && !getImmediate(right))
+                    std::swap(left, right);
+
                 // Generate in a new context
                 AssemblyContext ctxL("BinaryOperatorLeftOperand"), ctxR("BinaryOperatorRightOperand");
-                auto leftType = generateRightExpression(ctxL, left),
-                     rightType = generateRightExpression(ctxR, right);
+                auto leftType = generateRightExpression(ctxL, left);
+                bool leftIsDouble = checkNumberTypeIsDouble(leftType);
+
+                if (auto immediate = getImmediate(right); immediate && !leftIsDouble && op != AST::BinaryOperator::Slash) {
+                    ctx.append(std::move(ctxL));
+                    auto l = temporaries.get(ctx);
+                    if (op == AST::BinaryOperator::Plus)
+                        ctx.generate("add {}, {}", l, *immediate);
+                    else if (op == AST::BinaryOperator::Minus)
+                        ctx.generate("sub {}, {}", l, *immediate);
+                    else if (op == AST::BinaryOperator::Times)
+                        generateMultiplication(ctx, l, *immediate);
+                    else {
+                        ctx.generate("cmp {}, {}", l, *immediate);
+                        ctx.generate("{} al", getSetInstruction(op));
+                        ctx.generate("movzx {}, al", l);
+                    }
+
+                    return builtinTypeInteger;
+                }
 
-                bool leftIsDouble = checkNumberTypeIsDouble(leftType),
-                     rightIsDouble = checkNumberTypeIsDouble(rightType),
+                auto rightType = generateRightExpression(ctxR, right);
+                bool rightIsDouble = checkNumberTypeIsDouble(rightType),
                      useDouble = leftIsDouble || rightIsDouble || op == AST::BinaryOperator::Slash;
 
+                ctx.append(std::move(ctxL));
+                ctx.append(std::move(ctxR));
+
                 if (useDouble && !leftIsDouble) {
-                    ensureType(ctxL, builtinTypeInteger, builtinTypeDouble);
+                    ensureType(ctx, builtinTypeInteger, builtinTypeDouble, 1);
                 }
                 if (useDouble && !rightIsDouble) {
-                    ensureType(ctxR, builtinTypeInteger, builtinTypeDouble);
+                    ensureType(ctx, builtinTypeInteger, builtinTypeDouble);
                 }
 
-                ctx.append(std::move(ctxL));
-                ctx.append(std::move(ctxR));
-
+                auto r = temporaries.get(ctx), l = temporaries.get(ctx, 1);
                 if (useDouble) {
-                    ctx.generate("pop rax"); // r
-                    ctx.generate("movq xmm1, rax"); // r
-                    ctx.generate("pop rax"); // l
-                    ctx.generate("movq xmm0, rax"); // l
-
                     if (op >= AST::BinaryOperator::Plus) {
                         if (op == AST::BinaryOperator::Plus)
-                            ctx.generate("addsd xmm0, xmm1");
+                            ctx.generate("addsd {}, {}", l, r);
                         else if (op == AST::BinaryOperator::Minus)
-                            ctx.generate("subsd xmm0, xmm1");
+                            ctx.generate("subsd {}, {}", l, r);
                         else if (op == AST::BinaryOperator::Times)
-                            ctx.generate("mulsd xmm0, xmm1");
+                            ctx.generate("mulsd {}, {}", l, r);
                         else
-                            ctx.generate("divsd xmm0, xmm1");
-                        ctx.generate("movq rax, xmm0");
-                        ctx.generate("push rax");
-                        
+                            ctx.generate("divsd {}, {}", l, r);
+                        temporaries.pop(ctx);
+
                         return builtinTypeDouble;
                     } else {
+                        // The greater-than ones swap the operands, so unordered ones compare false
+                        // as with the branches on ucomisd
+                        bool swapped = op == AST::BinaryOperator::GreaterThan || op == AST::BinaryOperator::GreaterThanOrEqual;
                         if (op == AST::BinaryOperator::Equal)
-                            ctx.generate("cmpeqsd xmm0, xmm1");
+                            ctx.generate("cmpeqsd {}, {}", l, r);
                         else if (op == AST::BinaryOperator::NotEqual)
-                            ctx.generate("cmpneqsd xmm0, xmm1");
+                            ctx.generate("cmpneqsd {}, {}", l, r);
                         else if (op == AST::BinaryOperator::LessThan)
-                            ctx.generate("cmpltsd xmm0, xmm1");
+                            ctx.generate("cmpltsd {}, {}", l, r);
                         else if (op == AST::BinaryOperator::GreaterThan)
-                            ctx.generate("cmpnlesd xmm0, xmm1");
+                            ctx.generate("cmpltsd {}, {}", r, l);
                         else if (op == AST::BinaryOperator::LessThanOrEqual)
-                            ctx.generate("cmplesd xmm0, xmm1");
+                            ctx.generate("cmplesd {}, {}", l, r);
                         else if (op == AST::BinaryOperator::GreaterThanOrEqual)
-                            ctx.generate("cmpnltsd xmm0, xmm1");
-                        ctx.generate("movq rax, xmm0");
-                        ctx.generate("and rax, 1");
-                        ctx.generate("push rax");
+                            ctx.generate("cmplesd {}, {}", r, l);
+                        temporaries.pop(ctx);
+                        temporaries.pop(ctx);
+
+                        auto result = temporaries.push(ctx, false);
+                        ctx.generate("movq {}, {}", result, swapped ? r : l);
+                        ctx.generate("and {}, 1", result);
 
                         return builtinTypeInteger;
                     }
                 } else {
-                    ctx.generate("pop rsi"); // r
                     if (op >= AST::BinaryOperator::Plus) {
                         if (op == AST::BinaryOperator::Plus)
-                            ctx.generate("add qword ptr [rsp], rsi");
+                            ctx.generate("add {}, {}", l, r);
                         else if (op == AST::BinaryOperator::Minus)
-                            ctx.generate("sub qword ptr [rsp], rsi");
-                        else {
-                            ctx.generate("imul rsi, qword ptr [rsp]");
-                            ctx.generate("mov qword ptr [rsp], rsi");
-                        }
+                            ctx.generate("sub {}, {}", l, r);
+                        else
+                            ctx.generate("imul {}, {}", l, r);
                     } else {
-                        ctx.generate("xor rax, rax");
-                        ctx.generate("cmp qword ptr [rsp], rsi");
-                        if (op == AST::BinaryOperator::Equal)
-                            ctx.generate("sete al");
-                        else if (op == AST::BinaryOperator::NotEqual)
-                            ctx.generate("setne al");
-                        else if (op == AST::BinaryOperator::LessThan)
-                            ctx.generate("setl al");
-                        else if (op == AST::BinaryOperator::GreaterThan)
-                            ctx.generate("setg al");
-                        else if (op == AST::BinaryOperator::LessThanOrEqual)
-                            ctx.generate("setle al");
-                        else if (op == AST::BinaryOperator::GreaterThanOrEqual)
-                            ctx.generate("setge al");
-                        ctx.generate("mov qword ptr [rsp], rax");
+                        ctx.generate("cmp {}, {}", l, r);
+                        ctx.generate("{} al", getSetInstruction(op));
+                        ctx.generate("movzx {}, al", l);
                     }
+                    temporaries.pop(ctx);
 
                     return builtinTypeInteger;
                 }
@@ -894,29 +2906,74 @@ public:
             case AST::BinaryOperator::RightShift: {
                 // int op int = int
                 ensureType(ctx, generateRightExpression(ctx, left), builtinTypeInteger);
+
+                // idiv has no immediate form, but constant divisors don't need it
+                bool isDivision = op == AST::BinaryOperator::Div || op == AST::BinaryOperator::Mod;
+                if (auto immediate = getImmediate(right); immediate && isDivision && options.strengthReduction && *immediate != 0 && *immediate != -1) {
+                    auto range = getRange(left);
+                    generateDivision(ctx, temporaries.get(ctx), *immediate, op == AST::BinaryOperator::Mod, range && range->first >= 0);
+                    return builtinTypeInteger;
+                }
+                if (auto immediate = getImmediate(right); immediate && !isDivision) {
+                    auto l = temporaries.get(ctx);
+                    if (op == AST::BinaryOperator::Or)
+                        ctx.generate("or {}, {}", l, *immediate);
+                    else if (op == AST::BinaryOperator::Xor)
+                        ctx.generate("xor {}, {}", l, *immediate);
+                    else if (op == AST::BinaryOperator::And)
+                        ctx.generate("and {}, {}", l, *immediate);
+                    else if (op == AST::BinaryOperator::LeftShift)
+                        ctx.generate("shl {}, {}", l, *immediate & 63);
+                    else
+                        ctx.generate("shr {}, {}", l, *immediate & 63);
+
+                    return builtinTypeInteger;
+                }
+
                 ensureType(ctx, generateRightExpression(ctx, right), builtinTypeInteger);
-                ctx.generate("pop rcx"); // r
-                ctx.generate("pop rax"); // l
+                auto r = temporaries.get(ctx), l = temporaries.get(ctx, 1);
 
                 if (op == AST::BinaryOperator::Div) {
+                    ctx.generate("mov rax, {}", l);
                     ctx.generate("cqo");
-                    ctx.generate("idiv rcx");
+                    ctx.generate("idiv {}", r);
+                    ctx.generate("mov {}, rax", l);
                 } else if (op == AST::BinaryOperator::Mod) {
+                    ctx.generate("mov rax, {}", l);
                     ctx.generate("cqo");
-                    ctx.generate("idiv rcx");
-                    ctx.generate("mov rax, rdx");
+                    ctx.generate("idiv {}", r);
+                    ctx.generate("mov {}, rdx", l);
                 } else if (op == AST::BinaryOperator::Or)
-                    ctx.generate("or rax, rcx");
+                    ctx.generate("or {}, {}", l, r);
                 else if (op == AST::BinaryOperator::Xor)
-                    ctx.generate("xor rax, rcx");
+                    ctx.generate("xor {}, {}", l, r);
                 else if (op == AST::BinaryOperator::And)
-                    ctx.generate("and rax, rcx");
-                else if (op == AST::BinaryOperator::LeftShift)
-                    ctx.generate("shl rax, cl");
-                else
-                    ctx.generate("shr rax, cl");
+                    ctx.generate("and {}, {}", l, r);
+                else if (op == AST::BinaryOperator::LeftShift) {
+                    ctx.generate("mov rcx, {}", r);
+                    ctx.generate("shl {}, cl", l);
+                } else {
+                    ctx.generate("mov rcx, {}", r);
+                    ctx.generate("shr {}, cl", l);
+                }
+
+                temporaries.pop(ctx);
 
-                ctx.generate("push rax");
+                return builtinTypeInteger;
+            }
+            case AST::BinaryOperator::AndThen:
+            case AST::BinaryOperator::OrElse: {
+                // 1 if none of the jumps is taken, else 0
+                AssemblyContext ctxFalse("ShortCircuitFalse"), ctxExit("ShortCircuitExit");
+                generateShortCircuitJump(ctx, left, op == AST::BinaryOperator::AndThen, right, false, ctxFalse.getLabel(),
+                                         op == AST::BinaryOperator::AndThen ? "Operator AND THEN" : "Operator OR ELSE");
+                auto result = temporaries.push(ctx, false);
+                ctx.generate("mov {}, 1", result);
+                ctx.generate("jmp {}", ctxExit.getLabel());
+                ctxFalse.generate("xor {}, {}", result, result);
+                ctx.append(std::move(ctxFalse));
+                ctx.append(std::move(ctxExit));
+                forgetFrameBase();
 
                 return builtinTypeInteger;
             }
@@ -925,34 +2982,510 @@ public:
         }
     }
 
-    std::shared_ptr<Type> generateFunctionCall(AssemblyContext &ctx, std::shared_ptr<Function> function, std::list<std::shared_ptr<AST::Expression>> astArguments) {
+    // The body expression of a function whose calls can be expanded inline, or null with the reason
+    std::shared_ptr<AST::Expression> findInlineBody(std::shared_ptr<AST::Callable> astCallable, std::string &reason) const {
+        if (!function->returnType) { reason = "is a procedure"; return nullptr; }
+        for (auto [name, byReference, type] : function->parameters)
+            if (byReference || !type->isPlain()) { reason = "has a var parameter"; return nullptr; }
+        if (!astCallable->block->variables.empty()) { reason = "has local variables"; return nullptr; }
+        if (!astCallable->block->callables.empty()) { reason = "has nested functions"; return nullptr; }
+
+        auto stmt = astCallable->block->statement;
+        while (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            std::list<std::shared_ptr<AST::Statement>> statements;
+            for (auto sub : st->statements)
+                if (!std::dynamic_pointer_cast<AST::EmptyStatement>(sub)) statements.push_back(sub);
+            if (statements.size() != 1) break;
+            stmt = statements.front();
+        }
+        auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt);
+        auto lv = st ? std::dynamic_pointer_cast<AST::IdentifierExpression>(st->left) : nullptr;
+        if (!lv || lv->identifier != function->name) { reason = "is not a single assignment to its result"; return nullptr; }
+
+        return checkInlineExpression(st->right, reason) ? st->right : nullptr;
+    }
+
+    bool checkInlineExpression(std::shared_ptr<AST::Expression> expr, std::string &reason) const {
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            if (std::dynamic_pointer_cast<Function>(resolveSymbol(ex->identifier).second)) { reason = "calls a function"; return false; }
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            reason = "calls a function";
+            return false;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            return checkInlineExpression(ex->record, reason);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            for (auto index : ex->indexes) if (!checkInlineExpression(index, reason)) return false;
+            return checkInlineExpression(ex->array, reason);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            return checkInlineExpression(ex->pointer, reason);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            // The parameters are temporaries, which can't be reloaded on only one of the paths
+            if (ex->op == AST::BinaryOperator::AndThen || ex->op == AST::BinaryOperator::OrElse) {
+                reason = "short-circuits";
+                return false;
+            }
+            return checkInlineExpression(ex->leftOperand, reason) && checkInlineExpression(ex->rightOperand, reason);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            if (ex->op == AST::UnaryOperator::At) {
+                reason = "takes an address";
+                return false;
+            }
+            return checkInlineExpression(ex->operand, reason);
+        }
+        return true;
+    }
+
+    // Roughly the instructions an expression compiles to
+    static size_t getInlineCost(std::shared_ptr<AST::Expression> expr) {
+        if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            return 1 + getInlineCost(ex->record);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            size_t cost = 1 + getInlineCost(ex->array);
+            for (auto index : ex->indexes) cost += 4 + getInlineCost(index); // Bounds check and scaling
+            return cost;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            return 1 + getInlineCost(ex->pointer);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            return 1 + getInlineCost(ex->leftOperand) + getInlineCost(ex->rightOperand);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            return 1 + getInlineCost(ex->operand);
+        }
+        return 1;
+    }
+
+    // Expand a call if its body is at most twice as large as the call sequence it replaces:
+    // the static link and argument pushes, call, prologue, leave, ret, stack adjustment and
+    // the result's move
+    bool shouldInline(std::shared_ptr<Function> callee) const {
+        size_t benefit = 6 + callee->parameters.size() + callee->needStaticLink();
+        bool result = callee->inlineBody && callee->inlineCost <= benefit * 2;
+        if (options.inliningReport) {
+            auto caller = function ? function->name : "the program";
+            if (!callee->inlineBody)
+                std::cerr << fmt::format("inline: {} into {}: no, it {}\n", callee->name, caller, callee->inlineRejection);
+            else
+                std::cerr << fmt::format("inline: {} into {}: {}, cost {} and benefit {}\n", callee->name, caller, result ? "yes" : "no", callee->inlineCost, benefit);
+        }
+        return result;
+    }
+
+    // The arguments are evaluated and converted in order as for a call, but kept as temporaries
+    std::shared_ptr<Type> generateInlineCall(AssemblyContext &ctx, std::shared_ptr<Function> callee, std::list<std::shared_ptr<AST::Expression>> astArguments) {
+        std::map<std::string, std::pair<size_t, std::shared_ptr<Type>>> parameters;
+        size_t i = 0;
+        for (auto astArgument : astArguments) {
+            auto [name, byReference, type] = callee->parameters[i++];
+            ensureType(ctx, generateRightExpression(ctx, astArgument), type);
+            parameters[name] = {temporaries.size() - 1, type};
+        }
+
+        // The body has no calls, so expansions don't nest
+        inlineScope = callee->block.get();
+        inlineParameters = std::move(parameters);
+        auto type = generateRightExpression(ctx, callee->inlineBody);
+        inlineScope = nullptr;
+        inlineParameters.clear();
+
+        ensureType(ctx, type, callee->returnType);
+        temporaries.popBelowTop(ctx, astArguments.size());
+        return callee->returnType;
+    }
+
+    static void checkArgumentsCount(std::shared_ptr<Function> function, const std::list<std::shared_ptr<AST::Expression>> &astArguments) {
         if (function->parameters.size() != astArguments.size())
             reportError("Arguments count mismatch in function call to {}: expected {} but got {}", function->name, function->parameters.size(), astArguments.size());
-        for (size_t i = 0; i < (function->isBuiltinFunction ? 0 : function->level); i++) {
-            loadFrame(ctx, i);
+    }
+
+    // Load the address of an argument bound to a reference parameter into REG_LEFT_VALUE_POINTER
+    void generateReferenceArgument(AssemblyContext &ctx, std::shared_ptr<AST::Expression> astArgument, std::shared_ptr<Type> type) {
+        if (auto astMaybeLeftValueArgument = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(astArgument)) {
+            auto exprType = generateLeftExpression(ctx, astMaybeLeftValueArgument);
+            if (exprType != type)
+                reportError("Couldn't bind a value with type {} to a reference parameter with type {}", exprType->getSignature(), type->getSignature());
+        } else
+            reportError("Couldn't bind a right value to a reference parameter");
+    }
+
+    // Overwrite the parameters with the arguments, which are all evaluated first as they may read
+    // the parameters, then restart the function. The result is left in REG_RETURN_VALUE by the
+    // last iteration.
+    void generateTailCall(AssemblyContext &ctx, std::list<std::shared_ptr<AST::Expression>> astArguments) {
+        checkArgumentsCount(function, astArguments);
+
+        size_t i = 0;
+        for (auto astArgument : astArguments) {
+            auto [name, byReference, type] = function->parameters[i++];
+            if (byReference) {
+                generateReferenceArgument(ctx, astArgument, type);
+                ctx.generate("mov {}, {}", temporaries.push(ctx, false), REG_LEFT_VALUE_POINTER);
+            } else
+                ensureType(ctx, generateRightExpression(ctx, astArgument), type);
+        }
+
+        // The last argument is on the top
+        size_t nParams = function->parameters.size();
+        for (size_t i = nParams; i-- > 0; ) {
+            auto reg = temporaries.get(ctx);
+            if (!function->argumentRegisters.empty())
+                generateParameterStore(ctx, i, reg);
+            else
+                ctx.generate("{} qword ptr [rbp + {}], {}", getMoveInstruction(reg), (nParams + 1 - i) * 8, reg);
+            temporaries.pop(ctx);
+        }
+
+        if (frame.needFinalize()) {
+            loadFrame(ctx, level);
+            frame.onFinalize(ctx);
+        }
+        ctx.generate("jmp {}", tailCallLabel);
+        forgetFrameBase();
+    }
+
+    // Move the arguments, which are the top temporaries, to the registers their parameters are passed in
+    void generateArgumentMoves(AssemblyContext &ctx, const std::vector<std::string> &registers) {
+        size_t count = registers.size();
+        temporaries.get(ctx, count - 1); // Reloads the spilled ones
+        std::map<std::string, std::string> moves; // To the register from another
+        for (size_t i = 0; i < count; i++) {
+            auto reg = temporaries.get(ctx, count - 1 - i);
+            if (reg != registers[i]) moves[registers[i]] = reg;
+        }
+        for (size_t i = 0; i < count; i++) temporaries.pop(ctx);
+
+        // The registers are a permutation of some temporaries, which may have cycles to break with a
+        // scratch register
+        while (!moves.empty()) {
+            auto it = std::find_if(moves.begin(), moves.end(), [&](auto &move) {
+                return std::none_of(moves.begin(), moves.end(), [&](auto &other) { return other.second == move.first; });
+            });
+            if (it == moves.end()) {
+                it = moves.begin();
+                std::string scratch = isDoubleRegister(it->first) ? "xmm0" : "rax";
+                generateMove(ctx, scratch, it->first);
+                for (auto &move : moves)
+                    if (move.second == it->first) move.second = scratch;
+                continue;
+            }
+            generateMove(ctx, it->first, it->second);
+            moves.erase(it);
+        }
+    }
+
+    std::shared_ptr<Type> generateFunctionCall(AssemblyContext &ctx, std::shared_ptr<Function> function, std::list<std::shared_ptr<AST::Expression>> astArguments) {
+        checkArgumentsCount(function, astArguments);
+
+        if (!function->isBuiltinFunction && options.inlining && shouldInline(function))
+            return generateInlineCall(ctx, function, astArguments);
+
+        // The callee clobbers all temporary registers
+        temporaries.spill(ctx);
+
+        bool passStaticLink = !function->isBuiltinFunction && function->needStaticLink();
+        if (passStaticLink) {
+            loadFrame(ctx, function->level - 1);
             ctx.generate("push {}", REG_FRAME_BASE);
         }
 
         size_t i = 0;
+        bool inRegisters = !function->argumentRegisters.empty();
         for (auto astArgument : astArguments) {
             auto [name, byReference, type] = function->parameters[i++];
             if (byReference) {
-                if (auto astMaybeLeftValueArgument = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(astArgument)) {
-                    auto exprType = generateLeftExpression(ctx, astMaybeLeftValueArgument);
-                    if (exprType != type)
-                        reportError("Couldn't bind a value with type {} to a reference parameter with type {}", exprType->getSignature(), type->getSignature());
+                generateReferenceArgument(ctx, astArgument, type);
+                if (inRegisters)
+                    ctx.generate("mov {}, {}", temporaries.push(ctx, false), REG_LEFT_VALUE_POINTER);
+                else
                     ctx.generate("push {}", REG_LEFT_VALUE_POINTER);
-                } else
-                    reportError("Couldn't bind a right value to a reference parameter");
-            } else
+            } else {
                 ensureType(ctx, generateRightExpression(ctx, astArgument), type);
+                if (inRegisters) continue;
+                TemporaryAllocator::pushRegister(ctx, temporaries.get(ctx));
+                temporaries.pop(ctx);
+            }
         }
+        if (inRegisters) generateArgumentMoves(ctx, function->argumentRegisters);
         ctx.generate("call {}", function->isBuiltinFunction ? "builtin$" + function->name : function->label);
-        ctx.generate("add rsp, {}", ((function->isBuiltinFunction ? 0 : function->level) + function->parameters.size()) * 8);
-        ctx.generate("push {}", REG_RETURN_VALUE);
+        if (!function->isBuiltinFunction) callees.insert(function.get());
+        // The builtin functions preserve rbx, and only write through their references
+        if (!function->isBuiltinFunction) forgetFrameBase();
+        bool writesReferences = std::any_of(function->parameters.begin(), function->parameters.end(), [](auto &param) { return std::get<1>(param); });
+        if (!function->isBuiltinFunction || writesReferences) forgetValues(savedValues, std::nullopt);
+        if (size_t pushed = passStaticLink + function->getStackArguments()) ctx.generate("add rsp, {}", pushed * 8);
+        if (function->returnType) {
+            auto reg = temporaries.push(ctx, isDoubleType(function->returnType));
+            ctx.generate("{} {}, {}", isDoubleRegister(reg) ? "movq" : "mov", reg, REG_RETURN_VALUE);
+        }
         return function->returnType;
     }
 
+    const InductionPointer *getInductionPointer(const AST::ArrayAccessExpression *access) const {
+        if (!currentLoopPlan) return nullptr;
+        auto it = currentLoopPlan->accesses.find(access);
+        return it == currentLoopPlan->accesses.end() ? nullptr : &currentLoopPlan->pointers[it->second];
+    }
+
+    const LoopInvariant *getLoopInvariant(const AST::Expression *expr) const {
+        if (!currentLoopPlan) return nullptr;
+        auto it = currentLoopPlan->invariantIndexes.find(expr);
+        return it == currentLoopPlan->invariantIndexes.end() ? nullptr : &currentLoopPlan->invariants[it->second];
+    }
+
+    // The key of a value or address the run being generated saves, if it does
+    std::optional<std::string> getSavedKey(std::optional<std::string> key) const {
+        if (!key || !currentValueSlots || inlineScope || !currentValueSlots->count(*key)) return std::nullopt;
+        return key;
+    }
+
+    void saveValue(AssemblyContext &ctx, const std::string &key, std::shared_ptr<Type> type, const std::string &reg, const std::set<std::string> &variables) {
+        auto frameOffset = currentValueSlots->at(key);
+        ctx.generate("{} {}, {}", getMoveInstruction(reg), getMemoryOperand("rbp", frameOffset * 8), reg);
+        savedValues[key] = {frameOffset, type, variables, isLocalValue(variables)};
+    }
+
+    // Jump to the checked copy of the loop unless the variables indexing through the pointers stay
+    // in bounds, which the final value on the top of the machine stack does for a for loop's variable.
+    // Returns whether the copy is needed.
+    bool generateInductionGuard(AssemblyContext &ctx, const LoopPlan &plan, std::shared_ptr<AST::ForStatement> st,
+                                std::shared_ptr<Variable> var, const std::string &checkedLabel) {
+        if (!options.boundsCheck) return false;
+
+        bool needed = false;
+        auto check = [&](const std::string &operand, std::optional<long long> min, std::optional<long long> max) {
+            if (min) ctx.generate("cmp {}, {}", operand, *min);
+            if (min) ctx.generate("jl {}", checkedLabel);
+            if (max) ctx.generate("cmp {}, {}", operand, *max);
+            if (max) ctx.generate("jg {}", checkedLabel);
+            needed = true;
+        };
+        auto isInBounds = [](std::optional<std::pair<long long, long long>> range, long long min, long long max) {
+            return range && range->first >= min && range->second <= max;
+        };
+        for (auto [u, bounds] : plan.bounds) {
+            auto [min, max] = bounds;
+            auto known = u == var ? getRange(st->initialValue) : std::nullopt;
+            if (u != var) if (auto it = loopRanges.find(u); it != loopRanges.end()) known = it->second;
+            // The initial value is the lowest going up, the final one the highest, and conversely
+            bool up = u == var && st->direction == AST::ForStatement::Direction::Up;
+            bool knownFinal = u != var || isInBounds(getRange(st->finalValue), min, max);
+            if (isInBounds(known, min, max) && knownFinal) continue;
+
+            if (!isInBounds(known, min, max)) {
+                std::string operand = u->reg;
+                if (!u->isPromoted()) {
+                    loadVariableFrame(ctx, level, u);
+                    u->onLoadToRegister(ctx, operand = "rax");
+                }
+                if (u != var) check(operand, min, max);
+                else if (up) check(operand, min, std::nullopt);
+                else check(operand, std::nullopt, max);
+            }
+            if (!knownFinal) {
+                if (up) check("qword ptr [rsp]", std::nullopt, max);
+                else check("qword ptr [rsp]", min, std::nullopt);
+            }
+        }
+        return needed;
+    }
+
+    // Evaluate the pointers and the invariants of a loop into their slots
+    void generateLoopPreheader(AssemblyContext &ctx, LoopPlan &plan) {
+        for (auto &pointer : plan.pointers) {
+            generateLeftExpression(ctx, pointer.access);
+            ctx.generate("mov {}, {}", getMemoryOperand("rbp", pointer.frameOffset * 8), REG_LEFT_VALUE_POINTER);
+        }
+        for (auto &invariant : plan.invariants) {
+            invariant.type = generateRightExpression(ctx, invariant.expr);
+            auto reg = temporaries.get(ctx);
+            ctx.generate("{} {}, {}", getMoveInstruction(reg), getMemoryOperand("rbp", invariant.frameOffset * 8), reg);
+            temporaries.pop(ctx);
+        }
+    }
+
+    // Compute an expression of a vector loop lane by lane. Returns its register, and whether it's a
+    // temporary pushed for it rather than one holding a broadcast operand.
+    std::pair<std::string, bool> generateVectorExpression(AssemblyContext &ctx, std::shared_ptr<AST::Expression> expr, bool isDouble,
+                                                          const std::map<const AST::Expression *, std::string> &broadcasts) {
+        bool isAVX = options.instructionSet == InstructionSet::AVX2;
+        auto getVector = [&](const std::string &reg) { return isAVX ? "y" + reg.substr(1) : reg; };
+        if (auto it = broadcasts.find(expr.get()); it != broadcasts.end()) return {it->second, false};
+
+        if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            auto pointer = getInductionPointer(ex.get());
+            auto reg = temporaries.push(ctx, true);
+            ctx.generate("mov rax, {}", getMemoryOperand("rbp", pointer->frameOffset * 8));
+            ctx.generate("{}{} {}, {} ptr [rax]", isAVX ? "v" : "", isDouble ? "movupd" : "movdqu", getVector(reg), isAVX ? "ymmword" : "xmmword");
+            return {reg, true};
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            return generateVectorExpression(ctx, ex->operand, isDouble, broadcasts);
+        }
+
+        auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr);
+        auto [left, ownsLeft] = generateVectorExpression(ctx, ex->leftOperand, isDouble, broadcasts);
+        auto [right, ownsRight] = generateVectorExpression(ctx, ex->rightOperand, isDouble, broadcasts);
+        auto instruction = getVectorInstruction(ex->op, isDouble);
+        if (isAVX) {
+            auto result = ownsLeft ? left : ownsRight ? right : temporaries.push(ctx, true);
+            ctx.generate("v{} {}, {}, {}", instruction, getVector(result), getVector(left), getVector(right));
+            if (ownsLeft && ownsRight) temporaries.pop(ctx);
+            return {result, true};
+        }
+        if (ownsLeft) {
+            ctx.generate("{} {}, {}", instruction, left, right);
+            if (ownsRight) temporaries.pop(ctx);
+            return {left, true};
+        }
+        // Swapping doubles could change which NaN comes out
+        bool isCommutative = !isDouble && ex->op != AST::BinaryOperator::Minus;
+        if (ownsRight && isCommutative) {
+            ctx.generate("{} {}, {}", instruction, right, left);
+            return {right, true};
+        }
+        auto result = temporaries.push(ctx, true);
+        ctx.generate("{} {}, {}", isDouble ? "movapd" : "movdqa", result, left);
+        ctx.generate("{} {}, {}", instruction, result, right);
+        if (ownsRight) temporaries.popBelowTop(ctx, 1);
+        return {result, true};
+    }
+
+    // Run the iterations of a vector loop while a vector of them is left, advancing the loop variable and
+    // the pointers as the scalar loop after it expects. The guard has checked the bounds of them all.
+    void generateVectorLoop(AssemblyContext &ctx, const LoopPlan &plan, std::shared_ptr<Variable> var, size_t slevel) {
+        auto &loop = *plan.vectorLoop;
+        bool isAVX = options.instructionSet == InstructionSet::AVX2;
+        long long lanes = isAVX ? 4 : 2;
+        auto getVector = [&](const std::string &reg) { return isAVX ? "y" + reg.substr(1) : reg; };
+        currentLoopPlan = &plan;
+
+        // The invariant operands, and the sums of the lanes, stay in registers through the loop. A spilled
+        // temporary keeps only its low lane, so they're all computed before any is broadcast.
+        for (auto expr : loop.broadcasts) {
+            auto access = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr);
+            if (auto pointer = access ? getInductionPointer(access.get()) : nullptr) {
+                auto reg = temporaries.push(ctx, true);
+                ctx.generate("mov rax, {}", getMemoryOperand("rbp", pointer->frameOffset * 8));
+                ctx.generate("{} {}, qword ptr [rax]", loop.isDouble ? "movsd" : "movq", reg);
+                continue;
+            }
+            auto type = generateRightExpression(ctx, expr);
+            if (loop.isDouble)
+                ensureType(ctx, type, builtinTypeDouble);
+            else {
+                auto value = temporaries.get(ctx);
+                auto reg = temporaries.push(ctx, true);
+                ctx.generate("movq {}, {}", reg, value);
+                temporaries.popBelowTop(ctx, 1);
+            }
+        }
+        std::map<const AST::Expression *, std::string> broadcasts;
+        for (size_t i = 0; i < loop.broadcasts.size(); i++) {
+            auto reg = temporaries.get(ctx, loop.broadcasts.size() - 1 - i);
+            if (isAVX)
+                ctx.generate("{} {}, {}", loop.isDouble ? "vbroadcastsd" : "vpbroadcastq", getVector(reg), reg);
+            else
+                ctx.generate("{} {}, {}", loop.isDouble ? "unpcklpd" : "punpcklqdq", reg, reg);
+            broadcasts[loop.broadcasts[i].get()] = reg;
+        }
+        std::string sum;
+        if (loop.sum) {
+            sum = temporaries.push(ctx, true);
+            ctx.generate(isAVX ? "vpxor {0}, {0}, {0}" : "pxor {0}, {0}", getVector(sum));
+        }
+
+        AssemblyContext ctxVectorLoop("VectorLoop"), ctxVectorLoopExit("VectorLoopExit");
+        forgetFrameBase();
+        if (!var->isPromoted()) loadVariableFrame(ctxVectorLoop, slevel, var);
+        var->onLoadToRegister(ctxVectorLoop, "rax"); // i
+        ctxVectorLoop.generate("add rax, {}", lanes - 1);
+        ctxVectorLoop.generate("jo {}", ctxVectorLoopExit.getLabel());
+        ctxVectorLoop.generate("cmp rax, qword ptr [rsp]"); // i + lanes - 1 <=> final
+        ctxVectorLoop.generate("jg {}", ctxVectorLoopExit.getLabel());
+
+        auto [value, ownsValue] = generateVectorExpression(ctxVectorLoop, loop.value, loop.isDouble, broadcasts);
+        if (loop.sum) {
+            auto instruction = loop.subtracts ? "psubq" : "paddq";
+            if (isAVX)
+                ctxVectorLoop.generate("v{} {}, {}, {}", instruction, getVector(sum), getVector(sum), getVector(value));
+            else
+                ctxVectorLoop.generate("{} {}, {}", instruction, sum, value);
+        } else {
+            auto pointer = getInductionPointer(loop.store.get());
+            ctxVectorLoop.generate("mov rax, {}", getMemoryOperand("rbp", pointer->frameOffset * 8));
+            ctxVectorLoop.generate("{}{} {} ptr [rax], {}", isAVX ? "v" : "", loop.isDouble ? "movupd" : "movdqu",
+                                   isAVX ? "ymmword" : "xmmword", getVector(value));
+        }
+        if (ownsValue) temporaries.pop(ctxVectorLoop);
+
+        if (var->isPromoted())
+            ctxVectorLoop.generate("add {}, {}", var->reg, lanes);
+        else {
+            loadVariableFrame(ctxVectorLoop, slevel, var);
+            var->onLoadPointerToRegister(ctxVectorLoop);
+            ctxVectorLoop.generate("add qword ptr [{}], {}", REG_LEFT_VALUE_POINTER, lanes);
+        }
+        for (auto &pointer : plan.pointers) {
+            if (pointer.step == 0) continue;
+            ctxVectorLoop.generate("add {}, {}", getMemoryOperand("rbp", pointer.frameOffset * 8), pointer.step * lanes);
+        }
+        ctxVectorLoop.generate("jmp {}", ctxVectorLoop.getLabel());
+        ctx.append(std::move(ctxVectorLoop));
+
+        forgetFrameBase();
+        if (loop.sum) {
+            // Add up the lanes into the sum
+            auto temporary = temporaries.push(ctxVectorLoopExit, true);
+            if (isAVX) {
+                ctxVectorLoopExit.generate("vextracti128 {}, {}, 1", temporary, getVector(sum));
+                ctxVectorLoopExit.generate("vpaddq {0}, {0}, {1}", sum, temporary);
+            }
+            ctxVectorLoopExit.generate("{}pshufd {}, {}, 78", isAVX ? "v" : "", temporary, sum);
+            if (isAVX) ctxVectorLoopExit.generate("vpaddq {0}, {0}, {1}", sum, temporary);
+            else ctxVectorLoopExit.generate("paddq {}, {}", sum, temporary);
+            ctxVectorLoopExit.generate("{}movq rax, {}", isAVX ? "v" : "", sum);
+            temporaries.pop(ctxVectorLoopExit);
+            temporaries.pop(ctxVectorLoopExit);
+
+            if (loop.sum->isPromoted())
+                ctxVectorLoopExit.generate("add {}, rax", loop.sum->reg);
+            else {
+                loadVariableFrame(ctxVectorLoopExit, level, loop.sum);
+                loop.sum->onLoadPointerToRegister(ctxVectorLoopExit);
+                ctxVectorLoopExit.generate("add qword ptr [{}], rax", REG_LEFT_VALUE_POINTER);
+            }
+        }
+        if (isAVX) ctxVectorLoopExit.generate("vzeroupper");
+        for (size_t i = 0; i < loop.broadcasts.size(); i++) temporaries.pop(ctxVectorLoopExit);
+        ctx.append(std::move(ctxVectorLoopExit));
+        forgetFrameBase();
+        currentLoopPlan = nullptr;
+    }
+
+    // Generate a loop with its plan past the guard and the preheader, and a copy without the plan
+    // where the guard fails. A copy that falls through at its end jumps over the checked one.
+    template <typename GenerateLoop>
+    void generatePlannedLoop(AssemblyContext &ctx, LoopPlan &plan, std::shared_ptr<AST::ForStatement> st, std::shared_ptr<Variable> var,
+                             const std::string &name, bool fallsThrough, const std::string &exitLabel, GenerateLoop generateLoop) {
+        AssemblyContext ctxLoop(name), ctxCheckedLoop(name);
+        bool checked = generateInductionGuard(ctx, plan, st, var, ctxCheckedLoop.getLabel());
+
+        // Past the guard the accesses through the pointers, and any other with the same indexes,
+        // are in bounds
+        auto checkedRanges = loopRanges;
+        for (auto [u, bounds] : plan.bounds) {
+            auto [it, inserted] = loopRanges.try_emplace(u, bounds);
+            it->second = {std::max(it->second.first, bounds.first), std::min(it->second.second, bounds.second)};
+        }
+        generateLoopPreheader(ctx, plan);
+        generateLoop(ctxLoop, &plan);
+        if (checked && fallsThrough) ctxLoop.generate("jmp {}", exitLabel);
+        ctx.append(std::move(ctxLoop));
+
+        if (checked) {
+            loopRanges = std::move(checkedRanges);
+            generateLoop(ctxCheckedLoop, nullptr);
+            ctx.append(std::move(ctxCheckedLoop));
+        } else loopRanges = std::move(checkedRanges);
+    }
+
     std::shared_ptr<Type> generateLeftExpression(AssemblyContext &ctx, std::shared_ptr<AST::MaybeLeftValueExpression> expr) {
         // IdentifierExpression
         // RecordAccessExpression
@@ -962,7 +3495,8 @@ public:
             // "generateRightExpression()" won't reach here.
             auto [slevel, sym] = resolveSymbol(ex->identifier);
             if (auto var = std::dynamic_pointer_cast<Variable>(sym)) {
-                loadFrame(ctx, slevel);
+                markAccess(slevel, var);
+                loadVariableFrame(ctx, slevel, var);
                 var->onLoadPointerToRegister(ctx);
                 if (var->isReference) {
                     ctx.generate("mov {}, qword ptr [{}]", REG_LEFT_VALUE_POINTER, REG_LEFT_VALUE_POINTER);
@@ -976,18 +3510,24 @@ public:
             if (!type) reportError("Attempt to access a non-record lvalue's member: {}", ex->member);
 
             auto member = type->resolveMember(ex->member);
-            ctx.generate("mov {}, qword ptr [{}]", REG_FRAME_BASE, REG_LEFT_VALUE_POINTER);
-            member->onLoadPointerToRegister(ctx);
+            if (member->frameOffset != 0)
+                ctx.generate("lea {}, {}", REG_LEFT_VALUE_POINTER, getMemoryOperand(REG_LEFT_VALUE_POINTER, member->frameOffset * 8));
             return member->type;
         } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
-            AssemblyContext actx("ArrayAccessExpressionArrayEvaluation");
-            auto type = std::dynamic_pointer_cast<TypeArray>(generateLeftExpression(actx, ex->array));
-            if (!type) reportError("Attempt to access a non-array lvalue's member");
+            if (auto pointer = getInductionPointer(ex.get())) {
+                ctx.generate("mov {}, {}", REG_LEFT_VALUE_POINTER, getMemoryOperand("rbp", pointer->frameOffset * 8));
+                return pointer->type;
+            }
 
-            if (type->bounds.size() != ex->indexes.size())
-                reportError("Array subscription dimensions mismatch: expected {} but got {}", type->bounds.size(), ex->indexes.size());
+            std::set<std::string> variables;
+            auto key = getSavedKey(getAddressKey(ex, variables));
+            if (auto it = key ? savedValues.find(*key) : savedValues.end(); it != savedValues.end()) {
+                ctx.generate("mov {}, {}", REG_LEFT_VALUE_POINTER, getMemoryOperand("rbp", it->second.frameOffset * 8));
+                eliminatedExpressions++;
+                return it->second.type;
+            }
 
-            // The indexes are pushed to the stack in the reversed order
+            // The indexes are evaluated in the reversed order so the first one ends up on the top
             // Calculate the indexes first
             for (auto it = ex->indexes.rbegin(); it != ex->indexes.rend(); it++) {
                 if (!std::dynamic_pointer_cast<TypeInteger>(generateRightExpression(ctx, *it)))
@@ -995,17 +3535,31 @@ public:
             }
 
             // Calculate the array pointer then
-            ctx.append(std::move(actx));
+            auto type = std::dynamic_pointer_cast<TypeArray>(generateLeftExpression(ctx, ex->array));
+            if (!type) reportError("Attempt to access a non-array lvalue's member");
+
+            if (type->bounds.size() != ex->indexes.size())
+                reportError("Array subscription dimensions mismatch: expected {} but got {}", type->bounds.size(), ex->indexes.size());
 
-            ctx.generate("mov {}, qword ptr [{}]", REG_FRAME_BASE, REG_LEFT_VALUE_POINTER);
-            type->onLoadMemberPointerToRegister(ctx);
+            // Indexes proven in range aren't checked
+            std::vector<bool> checks;
+            size_t i = 0;
+            for (auto index : ex->indexes) {
+                auto [min, max] = type->bounds[i++];
+                auto range = getRange(index);
+                checks.push_back(options.boundsCheck && !(range && range->first >= min && range->second <= max));
+            }
+
+            type->onLoadMemberPointerToRegister(ctx, ctxCold, temporaries, checks);
+            if (key) saveValue(ctx, *key, type->memberType, REG_LEFT_VALUE_POINTER, variables);
 
             return type->memberType;
         } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
             auto type = std::dynamic_pointer_cast<TypePointer>(generateRightExpression(ctx, ex->pointer));
             if (!type) reportError("Attempt to dereference a non-pointer value");
 
-            ctx.generate("pop {}", REG_LEFT_VALUE_POINTER);
+            ctx.generate("mov {}, {}", REG_LEFT_VALUE_POINTER, temporaries.get(ctx));
+            temporaries.pop(ctx);
             return type->valueType;
         } else reportError("Bug!");
     }
@@ -1016,30 +3570,74 @@ public:
         // BinaryOperatorExpression
         // UnaryOperatorExpression
         // CallExpressionWithArguments
+        if (auto literal = constantPropagation.getConstant(expr.get())) {
+            auto constant = std::make_shared<Constant>(*literal);
+            constant->onLoadToRegister(ctx, temporaries.push(ctx, isDoubleType(constant->type)));
+            return constant->type;
+        }
+        if (auto invariant = getLoopInvariant(expr.get())) {
+            auto reg = temporaries.push(ctx, isDoubleType(invariant->type));
+            ctx.generate("{} {}, {}", getMoveInstruction(reg), reg, getMemoryOperand("rbp", invariant->frameOffset * 8));
+            return invariant->type;
+        }
+
+        std::set<std::string> variables;
+        auto key = getSavedKey(getValueKey(expr, variables));
+        if (!key) return generateExpressionValue(ctx, expr);
+        if (auto it = savedValues.find(*key); it != savedValues.end()) {
+            auto reg = temporaries.push(ctx, isDoubleType(it->second.type));
+            ctx.generate("{} {}, {}", getMoveInstruction(reg), reg, getMemoryOperand("rbp", it->second.frameOffset * 8));
+            eliminatedExpressions++;
+            return it->second.type;
+        }
+        auto type = generateExpressionValue(ctx, expr);
+        saveValue(ctx, *key, type, temporaries.get(ctx), variables);
+        return type;
+    }
+
+    std::shared_ptr<Type> generateExpressionValue(AssemblyContext &ctx, std::shared_ptr<AST::Expression> expr) {
         if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            if (auto it = inlineParameters.find(ex->identifier); inlineScope && it != inlineParameters.end()) {
+                auto [index, type] = it->second;
+                temporaries.pushCopy(ctx, temporaries.size() - 1 - index);
+                return type;
+            }
+
             auto [slevel, sym] = resolveSymbol(ex->identifier);
             if (auto var = std::dynamic_pointer_cast<Variable>(sym)) {
-                loadFrame(ctx, slevel);
-                var->onLoadToStack(ctx);
-                if (var->isReference) {
-                    ctx.generate("pop rax");
-                    ctx.generate("push qword ptr [rax]");
+                markAccess(slevel, var);
+                auto reg = temporaries.push(ctx, isDoubleType(var->type));
+                if (var->isPromoted()) {
+                    var->onLoadToRegister(ctx, reg);
+                    return var->type;
                 }
+                loadVariableFrame(ctx, slevel, var);
+                if (var->isReference) {
+                    var->onLoadToRegister(ctx, "rax");
+                    if (var->type->isAggregate())
+                        ctx.generate("mov {}, rax", reg);
+                    else
+                        ctx.generate("{} {}, qword ptr [rax]", getMoveInstruction(reg), reg);
+                } else
+                    var->onLoadToRegister(ctx, reg);
                 return var->type;
             } else if (auto cst = std::dynamic_pointer_cast<Constant>(sym)) {
-                cst->onLoadToStack(ctx);
+                cst->onLoadToRegister(ctx, temporaries.push(ctx, isDoubleType(cst->type)));
                 return cst->type;
             } else if (auto func = std::dynamic_pointer_cast<Function>(sym)) {
                 return generateFunctionCall(ctx, func, {});
             } else reportError("Bug!");
         } if (auto ex = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(expr)) {
             auto type = generateLeftExpression(ctx, ex);
-            ctx.generate("push qword ptr [{}]", REG_LEFT_VALUE_POINTER);
+            auto reg = temporaries.push(ctx, isDoubleType(type));
+            if (type->isAggregate())
+                ctx.generate("mov {}, {}", reg, REG_LEFT_VALUE_POINTER);
+            else
+                ctx.generate("{} {}, qword ptr [{}]", getMoveInstruction(reg), reg, REG_LEFT_VALUE_POINTER);
             return type;
         } else if (auto ex = std::dynamic_pointer_cast<AST::ConstantExpression>(expr)) {
             auto constant = std::make_shared<Constant>(ex->value);
-            constant->generate(constsContext);
-            constant->onLoadToStack(ctx);
+            constant->onLoadToRegister(ctx, temporaries.push(ctx, isDoubleType(constant->type)));
             return constant->type;
         } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
             return generateBinaryExpression(ctx, ex->leftOperand, ex->op, ex->rightOperand);
@@ -1048,11 +3646,10 @@ public:
                 auto type = generateRightExpression(ctx, ex->operand);
                 if (!std::dynamic_pointer_cast<TypeInteger>(type))
                     reportError("Unary operator NOT applied on a non-integer value");
-                ctx.generate("xor rcx, rcx");
-                ctx.generate("pop rax");
-                ctx.generate("test rax, rax");
-                ctx.generate("setz cl");
-                ctx.generate("push rcx");
+                auto reg = temporaries.get(ctx);
+                ctx.generate("test {}, {}", reg, reg);
+                ctx.generate("setz al");
+                ctx.generate("movzx {}, al", reg);
                 return type;
             } else if (ex->op == AST::UnaryOperator::Plus) {
                 auto type = generateRightExpression(ctx, ex->operand);
@@ -1062,13 +3659,13 @@ public:
                 return type;
             } else if (ex->op == AST::UnaryOperator::Minus) {
                 auto type = generateRightExpression(ctx, ex->operand);
+                auto reg = temporaries.get(ctx);
                 if (checkNumberTypeIsDouble(type)) {
-                    ctx.generate("xor rax, rax");
-                    ctx.generate("movsd xmm0, rax");
-                    ctx.generate("subsd xmm0, qword ptr [rsp]");
-                    ctx.generate("movsd qword ptr [rsp], xmm0");
+                    ctx.generate("xorpd xmm0, xmm0");
+                    ctx.generate("subsd xmm0, {}", reg);
+                    ctx.generate("movapd {}, xmm0", reg);
                 } else
-                    ctx.generate("neg qword ptr [rsp]");
+                    ctx.generate("neg {}", reg);
                 return type;
             } else if (ex->op == AST::UnaryOperator::At) {
                 auto le = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(ex->operand);
@@ -1076,7 +3673,7 @@ public:
                     reportError("Unary operator AT applied on a non-left value");
 
                 auto type = generateLeftExpression(ctx, le);
-                ctx.generate("push {}", REG_LEFT_VALUE_POINTER);
+                ctx.generate("mov {}, {}", temporaries.push(ctx, false), REG_LEFT_VALUE_POINTER);
                 return std::make_shared<TypePointer>(type);
             } else reportError("Bug!");
         } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
@@ -1087,7 +3684,167 @@ public:
         } else reportError("Bug!");
     }
 
+    bool isSelfAssignment(std::shared_ptr<AST::AssignmentStatement> st) const {
+        auto lv = std::dynamic_pointer_cast<AST::IdentifierExpression>(st->left);
+        auto rv = std::dynamic_pointer_cast<AST::IdentifierExpression>(st->right);
+        if (!lv || !rv) return false;
+        auto left = resolveSymbol(lv->identifier).second;
+        return std::dynamic_pointer_cast<Variable>(left) && left == resolveSymbol(rv->identifier).second;
+    }
+
+    // Pop the condition temporary and set ZF if it's zero
+    void generateConditionTest(AssemblyContext &ctx) {
+        auto reg = temporaries.get(ctx);
+        ctx.generate("test {}, {}", reg, reg);
+        temporaries.pop(ctx);
+    }
+
+    // The jump taken when a comparison holds, or doesn't. Doubles are compared by ucomisd, with the
+    // operands of the less-than ones swapped, so unordered ones compare false.
+    static const char *getJumpInstruction(AST::BinaryOperator op, bool holds, bool isDouble) {
+        switch (op) {
+            case AST::BinaryOperator::Equal: return holds ? "je" : "jne";
+            case AST::BinaryOperator::NotEqual: return holds ? "jne" : "je";
+            case AST::BinaryOperator::LessThan: return isDouble ? (holds ? "ja" : "jbe") : (holds ? "jl" : "jge");
+            case AST::BinaryOperator::GreaterThan: return isDouble ? (holds ? "ja" : "jbe") : (holds ? "jg" : "jle");
+            case AST::BinaryOperator::LessThanOrEqual: return isDouble ? (holds ? "jae" : "jb") : (holds ? "jle" : "jg");
+            case AST::BinaryOperator::GreaterThanOrEqual: return isDouble ? (holds ? "jae" : "jb") : (holds ? "jge" : "jl");
+            default: reportError("Bug!");
+        }
+    }
+
+    // Whether an expression always evaluates to 0 or 1
+    bool isTruthValue(std::shared_ptr<AST::Expression> expr) const {
+        if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) return ex->op == AST::UnaryOperator::Not;
+        auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr);
+        return ex && (ex->op < AST::BinaryOperator::Plus || isShortCircuit(ex));
+    }
+
+    // Whether evaluating a number expression may fault
+    static bool canTrap(std::shared_ptr<AST::Expression> expr) {
+        if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            if (ex->op == AST::BinaryOperator::Div || ex->op == AST::BinaryOperator::Mod) {
+                auto divisor = getImmediate(ex->rightOperand);
+                if (!divisor || *divisor == 0 || *divisor == -1) return true;
+            }
+            return canTrap(ex->leftOperand) || canTrap(ex->rightOperand);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            return canTrap(ex->operand);
+        }
+        return false;
+    }
+
+    // Whether an operator is branched on operand by operand. A bitwise and / or of two truth values is
+    // too, as long as skipping its right operand can't be told, i.e. it only reads numbers and can't trap.
+    bool isShortCircuit(std::shared_ptr<AST::BinaryOperatorExpression> ex) const {
+        if (ex->op == AST::BinaryOperator::AndThen || ex->op == AST::BinaryOperator::OrElse) return true;
+        if (!options.shortCircuit || (ex->op != AST::BinaryOperator::And && ex->op != AST::BinaryOperator::Or)) return false;
+        return isTruthValue(ex->leftOperand) && isTruthValue(ex->rightOperand) &&
+               getValueCost(ex->rightOperand) && !canTrap(ex->rightOperand);
+    }
+
+    // Jump to a label if "left and right" (or "left or right") is true, or false. The right operand is
+    // only evaluated on one of the paths, so nothing it leaves behind is known after it.
+    void generateShortCircuitJump(AssemblyContext &ctx, std::shared_ptr<AST::Expression> left, bool isAnd,
+                                  std::shared_ptr<AST::Expression> right, bool jumpIf,
+                                  const std::string &label, const std::string &statementName) {
+        temporaries.spill(ctx);
+
+        // The left operand alone decides the jump when it's false for and, or true for or
+        AssemblyContext ctxSkip("ShortCircuit");
+        if (jumpIf == isAnd)
+            generateConditionJump(ctx, left, !jumpIf, ctxSkip.getLabel(), statementName);
+        else
+            generateConditionJump(ctx, left, jumpIf, label, statementName);
+
+        auto outerValues = savedValues;
+        generateConditionJump(ctx, right, jumpIf, label, statementName);
+        for (auto it = savedValues.begin(); it != savedValues.end(); ) {
+            if (!outerValues.count(it->first)) it = savedValues.erase(it);
+            else it++;
+        }
+
+        if (jumpIf == isAnd) {
+            ctx.append(std::move(ctxSkip));
+            forgetFrameBase();
+        }
+    }
+
+    // Jump to a label if a condition is true, or false, without materializing its value: comparisons
+    // branch on the flags they set, negations swap the sense and and / or branch on each operand
+    void generateConditionJump(AssemblyContext &ctx, std::shared_ptr<AST::Expression> condition, bool jumpIf,
+                               const std::string &label, const std::string &statementName) {
+        // Known or hoisted conditions are loaded as they are
+        bool isComputed = constantPropagation.getConstant(condition.get()) || getLoopInvariant(condition.get());
+        if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(condition); ex && !isComputed && ex->op == AST::UnaryOperator::Not)
+            return generateConditionJump(ctx, ex->operand, !jumpIf, label, statementName);
+
+        // The comparison operators come first
+        auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(condition);
+        if (ex && !isComputed && isShortCircuit(ex)) {
+            bool isAnd = ex->op == AST::BinaryOperator::AndThen || ex->op == AST::BinaryOperator::And;
+            return generateShortCircuitJump(ctx, ex->leftOperand, isAnd, ex->rightOperand, jumpIf, label, statementName);
+        }
+        if (isComputed || !ex || ex->op >= AST::BinaryOperator::Plus) {
+            if (!std::dynamic_pointer_cast<TypeInteger>(generateRightExpression(ctx, condition)))
+                reportError("{}'s condition is not integer type", statementName);
+            generateConditionTest(ctx);
+            ctx.generate("{} {}", jumpIf ? "jnz" : "jz", label);
+            return;
+        }
+
+        bool leftIsDouble = checkNumberTypeIsDouble(generateRightExpression(ctx, ex->leftOperand));
+        if (auto immediate = getImmediate(ex->rightOperand); immediate && !leftIsDouble) {
+            ctx.generate("cmp {}, {}", temporaries.get(ctx), *immediate);
+            temporaries.pop(ctx);
+            ctx.generate("{} {}", getJumpInstruction(ex->op, jumpIf, false), label);
+            return;
+        }
+
+        bool rightIsDouble = checkNumberTypeIsDouble(generateRightExpression(ctx, ex->rightOperand)),
+             useDouble = leftIsDouble || rightIsDouble;
+        if (useDouble && !leftIsDouble) ensureType(ctx, builtinTypeInteger, builtinTypeDouble, 1);
+        if (useDouble && !rightIsDouble) ensureType(ctx, builtinTypeInteger, builtinTypeDouble);
+
+        auto r = temporaries.get(ctx), l = temporaries.get(ctx, 1);
+        bool swapped = useDouble && (ex->op == AST::BinaryOperator::LessThan || ex->op == AST::BinaryOperator::LessThanOrEqual);
+        ctx.generate("{} {}, {}", useDouble ? "ucomisd" : "cmp", swapped ? r : l, swapped ? l : r);
+        temporaries.pop(ctx);
+        temporaries.pop(ctx);
+
+        if (useDouble && (ex->op == AST::BinaryOperator::Equal || ex->op == AST::BinaryOperator::NotEqual)) {
+            // Unordered operands set the parity flag, and compare unequal
+            if ((ex->op == AST::BinaryOperator::Equal) == jumpIf) {
+                AssemblyContext ctxUnordered("Unordered");
+                ctx.generate("jp {}", ctxUnordered.getLabel());
+                ctx.generate("je {}", label);
+                ctx.append(std::move(ctxUnordered));
+            } else {
+                ctx.generate("jne {}", label);
+                ctx.generate("jp {}", label);
+            }
+        } else
+            ctx.generate("{} {}", getJumpInstruction(ex->op, jumpIf, useDouble), label);
+    }
+
     AssemblyContext generateStatement(std::shared_ptr<AST::Statement> stmt = nullptr) {
+        if (!stmt) return generateStatementCode(stmt);
+
+        // The values saved along a run are kept from one of its statements to the next only
+        auto it = straightLinePositions.find(stmt.get());
+        bool continues = false;
+        if (auto last = straightLinePositions.find(lastStraightLine); it != straightLinePositions.end() && last != straightLinePositions.end())
+            continues = last->second.first == it->second.first && last->second.second + 1 == it->second.second;
+        if (!continues) savedValues.clear();
+
+        currentValueSlots = it != straightLinePositions.end() ? &valueSlots[it->second.first] : nullptr;
+        auto ctx = generateStatementCode(stmt);
+        currentValueSlots = nullptr;
+        lastStraightLine = it != straightLinePositions.end() ? stmt.get() : nullptr;
+        return ctx;
+    }
+
+    AssemblyContext generateStatementCode(std::shared_ptr<AST::Statement> stmt) {
         // AssignmentStatement
         // ExplicitCallStatement
         // CompoundStatement
@@ -1098,49 +3855,93 @@ public:
         // ExpressionStatement
         // EmptyStatement
         AssemblyContext ctx(stmt ? "Statement" : "NullStatement");
+        if (tailCalls.count(stmt.get())) {
+            std::shared_ptr<AST::Expression> call;
+            if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) call = st->right;
+            else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) call = st->expression;
+            auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(call);
+            generateTailCall(ctx, ex ? ex->argumentList : std::list<std::shared_ptr<AST::Expression>>{});
+            return ctx;
+        }
         if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            // Including the copies between coalesced variables
+            if (isSelfAssignment(st)) return ctx;
+
+            if (movedAssignments.count(st.get())) {
+                auto sourceType = generateLeftExpression(ctx, std::dynamic_pointer_cast<AST::IdentifierExpression>(st->right));
+                ctx.generate("mov {}, {}", temporaries.push(ctx, false), REG_LEFT_VALUE_POINTER);
+                auto leftType = generateLeftExpression(ctx, st->left);
+                ensureType(ctx, sourceType, leftType);
+                leftType->onMove(ctx, temporaries.get(ctx));
+                temporaries.pop(ctx);
+                forgetAssignedValues(savedValues, st->left);
+                return ctx;
+            }
+
             auto rightType = generateRightExpression(ctx, st->right);
 
             if (auto lv = std::dynamic_pointer_cast<AST::IdentifierExpression>(st->left); lv && function && lv->identifier == function->name) {
                 // return value assignment
                 ensureType(ctx, rightType, function->returnType);
-                ctx.generate("pop {}", REG_RETURN_VALUE);
+                auto reg = temporaries.get(ctx);
+                ctx.generate("{} {}, {}", isDoubleRegister(reg) ? "movq" : "mov", REG_RETURN_VALUE, reg);
+            } else if (auto var = getPromotedVariable(st->left)) {
+                ensureType(ctx, rightType, var->type);
+                generateMove(ctx, var->reg, temporaries.get(ctx));
             } else {
                 auto leftType = generateLeftExpression(ctx, st->left);
                 ensureType(ctx, rightType, leftType);
-                leftType->onAssign(ctx);
+                leftType->onAssign(ctx, temporaries.get(ctx));
             }
+            temporaries.pop(ctx);
+            forgetAssignedValues(savedValues, st->left);
         } else if (auto st = std::dynamic_pointer_cast<AST::ExplicitCallStatement>(stmt)) {
             auto [slevel, sym] = resolveSymbol(st->functionName);
             auto func = std::dynamic_pointer_cast<Function>(sym);
             if (!func) reportError("No such function: {}", st->functionName);
-            generateFunctionCall(ctx, func, {});
-            ctx.generate("add rsp, 8"); // ignore return value
+            if (generateFunctionCall(ctx, func, {})) temporaries.pop(ctx); // ignore return value
         } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
             for (auto sub : st->statements) {
                 ctx.append(generateStatement(sub));
             }
         } else if (auto st = std::dynamic_pointer_cast<AST::WhileStatement>(stmt)) {
-            if (!std::dynamic_pointer_cast<TypeInteger>(generateRightExpression(ctx, st->condition)))
-                reportError("While's condition is not integer type");
+            if (getKnownCondition(st->condition) == false) return ctx;
 
             auto ctxExitLoop = generateStatement();
-            ctx.generate("pop rax");
-            ctx.generate("test rax, rax");
-            ctx.generate("jz {}", ctxExitLoop.getLabel());
+            auto generateLoop = [&](AssemblyContext &ctxLoop, const LoopPlan *plan) {
+                forgetFrameBase();
+                currentLoopPlan = plan;
+                generateConditionJump(ctxLoop, st->condition, false, ctxExitLoop.getLabel(), "While");
 
-            ctx.append(generateStatement(st->statement));
+                ctxLoop.append(generateStatement(st->statement));
+                currentLoopPlan = nullptr;
 
-            ctx.generate("jmp {}", ctx.getLabel());
+                ctxLoop.generate("jmp {}", ctxLoop.getLabel());
+            };
+
+            if (auto it = loopPlans.find(st.get()); it != loopPlans.end())
+                generatePlannedLoop(ctx, it->second, nullptr, nullptr, "WhileLoop", false, ctxExitLoop.getLabel(), generateLoop);
+            else
+                generateLoop(ctx, nullptr);
             ctx.append(std::move(ctxExitLoop));
+            forgetFrameBase();
         } else if (auto st = std::dynamic_pointer_cast<AST::RepeatStatement>(stmt)) {
-            ctx.append(generateStatement(st->statement));
-
-            if (!std::dynamic_pointer_cast<TypeInteger>(generateRightExpression(ctx, st->condition)))
-                reportError("Repeat's condition is not integer type");
-            ctx.generate("pop rax");
-            ctx.generate("test rax, rax");
-            ctx.generate("jz {}", ctx.getLabel());
+            auto generateLoop = [&](AssemblyContext &ctxLoop, const LoopPlan *plan) {
+                forgetFrameBase();
+                currentLoopPlan = plan;
+                ctxLoop.append(generateStatement(st->statement));
+
+                generateConditionJump(ctxLoop, st->condition, false, ctxLoop.getLabel(), "Repeat");
+                currentLoopPlan = nullptr;
+            };
+
+            if (auto it = loopPlans.find(st.get()); it != loopPlans.end()) {
+                auto ctxExitLoop = generateStatement();
+                generatePlannedLoop(ctx, it->second, nullptr, nullptr, "RepeatLoop", true, ctxExitLoop.getLabel(), generateLoop);
+                ctx.append(std::move(ctxExitLoop));
+                forgetFrameBase();
+            } else
+                generateLoop(ctx, nullptr);
         } else if (auto st = std::dynamic_pointer_cast<AST::ForStatement>(stmt)) {
             auto [slevel, sym] = resolveSymbol(st->variable);
             auto var = std::dynamic_pointer_cast<Variable>(sym);
@@ -1148,62 +3949,123 @@ public:
                 reportError("For's variable is not a variable");
             if (!std::dynamic_pointer_cast<TypeInteger>(var->type))
                 reportError("For's variable is not integer type");
+            markAccess(slevel, var);
 
             auto initialValueType = generateRightExpression(ctx, st->initialValue);
             ensureType(ctx, initialValueType, var->type);
 
-            loadFrame(ctx, slevel);
-            var->onLoadPointerToRegister(ctx);
-            var->type->onAssign(ctx);
+            if (var->isPromoted())
+                generateMove(ctx, var->reg, temporaries.get(ctx));
+            else {
+                loadVariableFrame(ctx, slevel, var);
+                var->onLoadPointerToRegister(ctx);
+                var->type->onAssign(ctx, temporaries.get(ctx));
+            }
+            temporaries.pop(ctx);
 
             auto finalValueType = generateRightExpression(ctx, st->finalValue);
+            ensureType(ctx, finalValueType, var->type);
+
+            // The body sees the variable between the initial and final values if nothing else can change it
+            std::optional<std::pair<long long, long long>> range;
+            auto initialRange = getRange(st->initialValue), finalRange = getRange(st->finalValue);
+            if (initialRange && finalRange && slevel == level && !var->isEscaping && !var->isReference &&
+                !checkAssigns(st->statement, st->variable)) {
+                if (st->direction == AST::ForStatement::Direction::Up)
+                    range = {initialRange->first, finalRange->second};
+                else
+                    range = {finalRange->first, initialRange->second};
+            }
+
+            // The final value stays on the machine stack during the loop
+            temporaries.spill(ctx);
 
             AssemblyContext ctxExitLoop("ForLoopExit");
-            ctxExitLoop.generate("add rsp, 8"); // pop final value
-
-            AssemblyContext ctxLoop("ForLoop");
-            loadFrame(ctxLoop, slevel);
-            var->onLoadToStack(ctxLoop);
-            ctxLoop.generate("pop rsi"); // i
-            ctxLoop.generate("cmp rsi, qword ptr [rsp]"); // i <=> final
-            if (st->direction == AST::ForStatement::Direction::Up)
-                ctxLoop.generate("jg {}", ctxExitLoop.getLabel());
-            else
-                ctxLoop.generate("jl {}", ctxExitLoop.getLabel());
-            
-            ctxLoop.append(generateStatement(st->statement));
-
-            // Modify the loop variable
-            loadFrame(ctxLoop, slevel);
-            var->onLoadPointerToRegister(ctxLoop);
-            if (st->direction == AST::ForStatement::Direction::Up)
-                ctxLoop.generate("inc qword ptr [{}]", REG_LEFT_VALUE_POINTER);
-            else
-                ctxLoop.generate("dec qword ptr [{}]", REG_LEFT_VALUE_POINTER);
 
-            ctxLoop.generate("jmp {}", ctxLoop.getLabel());
+            auto generateScalarLoop = [&](AssemblyContext &ctxLoop, const LoopPlan *plan) {
+                forgetFrameBase();
+                if (var->isPromoted())
+                    ctxLoop.generate("cmp {}, qword ptr [rsp]", var->reg); // i <=> final
+                else {
+                    loadVariableFrame(ctxLoop, slevel, var);
+                    var->onLoadToRegister(ctxLoop, "rax"); // i
+                    ctxLoop.generate("cmp rax, qword ptr [rsp]"); // i <=> final
+                }
+                if (st->direction == AST::ForStatement::Direction::Up)
+                    ctxLoop.generate("jg {}", ctxExitLoop.getLabel());
+                else
+                    ctxLoop.generate("jl {}", ctxExitLoop.getLabel());
+
+                currentLoopPlan = plan;
+                ctxLoop.append(generateStatement(st->statement));
+                currentLoopPlan = nullptr;
+
+                // Modify the loop variable
+                if (var->isPromoted())
+                    ctxLoop.generate("{} {}", st->direction == AST::ForStatement::Direction::Up ? "inc" : "dec", var->reg);
+                else {
+                    loadVariableFrame(ctxLoop, slevel, var);
+                    var->onLoadPointerToRegister(ctxLoop);
+                    if (st->direction == AST::ForStatement::Direction::Up)
+                        ctxLoop.generate("inc qword ptr [{}]", REG_LEFT_VALUE_POINTER);
+                    else
+                        ctxLoop.generate("dec qword ptr [{}]", REG_LEFT_VALUE_POINTER);
+                }
+                if (plan) {
+                    for (auto &pointer : plan->pointers) {
+                        if (pointer.step == 0) continue;
+                        ctxLoop.generate("{} {}, {}", st->direction == AST::ForStatement::Direction::Up ? "add" : "sub",
+                                         getMemoryOperand("rbp", pointer.frameOffset * 8), pointer.step);
+                    }
+                }
+
+                ctxLoop.generate("jmp {}", ctxLoop.getLabel());
+            };
+            // The scalar loop finishes what's left of the iterations of a vector loop
+            auto generateLoop = [&](AssemblyContext &ctxLoop, const LoopPlan *plan) {
+                if (!plan || !plan->vectorLoop) return generateScalarLoop(ctxLoop, plan);
+                generateVectorLoop(ctxLoop, *plan, var, slevel);
+                AssemblyContext ctxScalarLoop("ForLoop");
+                generateScalarLoop(ctxScalarLoop, plan);
+                ctxLoop.append(std::move(ctxScalarLoop));
+            };
+
+            auto outerRanges = loopRanges;
+            if (range) loopRanges[var] = *range;
+            if (auto it = loopPlans.find(st.get()); it != loopPlans.end()) {
+                generatePlannedLoop(ctx, it->second, st, var, "ForLoop", false, ctxExitLoop.getLabel(), generateLoop);
+            } else {
+                AssemblyContext ctxLoop("ForLoop");
+                generateLoop(ctxLoop, nullptr);
+                ctx.append(std::move(ctxLoop));
+            }
+            loopRanges = std::move(outerRanges);
+
+            temporaries.pop(ctxExitLoop); // pop final value
 
-            ctx.append(std::move(ctxLoop));
             ctx.append(std::move(ctxExitLoop));
+            forgetFrameBase();
         } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
-            if (!std::dynamic_pointer_cast<TypeInteger>(generateRightExpression(ctx, st->condition)))
-                reportError("If's condition is not integer type");
+            if (auto known = getKnownCondition(st->condition)) {
+                ctx.append(generateStatement(*known ? st->statementForTrue : st->statementForFalse));
+                return ctx;
+            }
 
+            AssemblyContext ctxElse("Else");
+            generateConditionJump(ctx, st->condition, false, ctxElse.getLabel(), "If");
             auto ctxTrue = generateStatement(st->statementForTrue);
+            forgetFrameBase();
             auto ctxFalse = generateStatement(st->statementForFalse);
+            forgetFrameBase();
             auto ctxExit = generateStatement();
 
-            ctx.generate("pop rax");
-            ctx.generate("test rax, rax");
-            ctx.generate("jz {}", ctxFalse.getLabel());
-
             ctx.append(std::move(ctxTrue));
             ctx.generate("jmp {}", ctxExit.getLabel());
+            ctx.append(std::move(ctxElse));
             ctx.append(std::move(ctxFalse));
             ctx.append(std::move(ctxExit));
         } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
-            generateRightExpression(ctx, st->expression);
-            ctx.generate("add rsp, 8"); // ignore expression value
+            if (generateRightExpression(ctx, st->expression)) temporaries.pop(ctx); // ignore expression value
         } else {
             ctx.generate("nop");
         }
@@ -1228,21 +4090,73 @@ void Function::init(std::shared_ptr<Function> sharedThis, std::shared_ptr<AST::C
             reportError("Return type {} is not allowed to be passed by value", returnType->getSignature());
     }
     
+    // Arguments of the scalar types are evaluated into the temporaries, so they're passed in them if
+    // they all fit
+    if (options.registerArguments) {
+        size_t integers = 0, doubles = 0;
+        for (auto [name, byReference, type] : parameters) {
+            if (!byReference && isDoubleType(type)) {
+                if (doubles < REG_DOUBLE_TEMPORARIES.size()) argumentRegisters.push_back(REG_DOUBLE_TEMPORARIES[doubles]);
+                doubles++;
+            } else if (byReference || std::dynamic_pointer_cast<TypeInteger>(type)) {
+                if (integers < REG_TEMPORARIES.size()) argumentRegisters.push_back(REG_TEMPORARIES[integers]);
+                integers++;
+            }
+        }
+        if (argumentRegisters.size() != parameters.size()) argumentRegisters.clear();
+    }
+
     name = astCallable->name;
     isBuiltinFunction = false;
     block = std::make_shared<Block>(sharedThis, parentBlock, astCallable->block);
+    inlineBody = block->findInlineBody(astCallable, inlineRejection);
+    if (inlineBody) inlineCost = Block::getInlineCost(inlineBody);
 }
 
 std::string generateCode(std::shared_ptr<AST::Block> astRootBlock) {
     auto block = std::make_shared<Block>(nullptr, nullptr, astRootBlock);
 
+    // Leave out the functions never called, or expanded inline wherever they are
+    std::set<const Block *> reachable = {block.get()};
+    std::vector<const Block *> pending = {block.get()};
+    while (!pending.empty()) {
+        auto caller = pending.back();
+        pending.pop_back();
+        for (auto callee : caller->callees)
+            if (reachable.insert(callee->block.get()).second) pending.push_back(callee->block.get());
+    }
+
     AssemblyContext ctx("TopLevel");
-    ctx.append(std::move(constsContext));
-    for (auto func : blocks) ctx.append(std::move(func->ctx));
+    for (auto func : blocks) {
+        if (options.deadFunctionElimination && !reachable.count(func)) continue;
+        if (options.commonSubexpressionsReport)
+            std::cerr << fmt::format("cse: {}: {} expressions eliminated\n", func->function ? func->function->name : "the program", func->eliminatedExpressions);
+        ctx.append(std::move(func->ctx));
+    }
+
+    if (options.peephole) {
+        PeepholeOptimizer optimizer;
+        ctx.optimize(optimizer, {block->label});
+        if (options.peepholeStatistics) optimizer.printStatistics(std::cerr);
+    }
+
+    std::string bss;
+    for (auto [name, var] : block->frame.variables) {
+        if (!var->isPromoted()) bss += fmt::format("{}:\n    .zero {}\n", var->symbol, var->type->getSize());
+    }
+    if (options.nonLocalAccess == NonLocalAccess::Display) {
+        size_t depth = 0;
+        for (auto func : blocks) depth = std::max(depth, func->level + 1);
+        bss += fmt::format(".Display:\n    .zero {}\n", depth * 8);
+    }
+    if (!bss.empty()) bss = ".bss\n.p2align 3\n" + bss;
 
+    auto code = ctx.getCode();
     return ".intel_syntax noprefix\n"
-           ".text\n"
-         + ctx.getCode()
+         + constantPool.getCode(code)
+         + bss
+         + ".text\n"
+         + code
          + ".globl main\n"
            "main:\n"
            "    push rbp\n"
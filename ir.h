@@ -0,0 +1,755 @@
+#ifndef _MENCI_IR_H
+#define _MENCI_IR_H
+
+#include <string>
+#include <list>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <optional>
+#include <cstring>
+#include <ostream>
+#include <fmt/format.h>
+
+#include "ast.h"
+#include "ast-fold.h"
+
+// A typed SSA form of each function, lowered from the AST for the analyses that need it, SCCP for
+// now. The code is still generated from the AST, which the results are applied to by expression.
+//
+// The codegen resolves the names, so the IR agrees with it on what each refers to, and decides
+// which variables are promoted: the scalar ones local to the function and never accessed by
+// address or from a nested function become SSA values with phi nodes; everything else is accessed
+// with explicit loads and stores to frame slots or computed addresses.
+namespace IR {
+
+// Strings, records, arrays and pointers are all opaque to the IR
+enum class Type { Void, Integer, Double, Other };
+
+inline const char *getTypeName(Type type) {
+    switch (type) {
+        case Type::Void: return "void";
+        case Type::Integer: return "integer";
+        case Type::Double: return "double";
+        default: return "other";
+    }
+}
+
+struct Slot {
+    std::string name;
+    Type type;
+    bool isParameter, isReference;
+    bool promotable;
+};
+
+struct Signature {
+    std::vector<bool> byReference;
+    Type returnType;
+};
+
+enum class Opcode {
+    Constant,        // name = literal
+    Parameter,       // slot = the parameter
+    Undefined,
+    LoadSlot,        // slot
+    StoreSlot,       // slot <- operands[0]
+    Address,         // slot, or operands[0] = base address, name = member, operands[1..] = indexes
+    Load,            // *operands[0]
+    Store,           // *operands[0] <- operands[1]
+    Binary,
+    Unary,
+    IntegerToDouble,
+    DoubleToInteger,
+    Call,            // name = callee
+    Phi,             // operands[i] comes from block->predecessors[i]
+    Jump,            // targets[0]
+    Branch,          // operands[0] != 0 ? targets[0] : targets[1]
+    Return
+};
+
+struct BasicBlock;
+
+struct Instruction {
+    size_t id;
+    Opcode opcode;
+    Type type;
+    std::vector<Instruction *> operands;
+    BasicBlock *block;
+    AST::BinaryOperator binaryOperator;
+    AST::UnaryOperator unaryOperator;
+    std::string name;
+    std::shared_ptr<Slot> slot;
+    std::vector<BasicBlock *> targets;
+    bool removed = false;
+
+    std::string getName() const { return fmt::format("%{}", id); }
+};
+
+struct BasicBlock {
+    size_t id;
+    std::list<Instruction *> instructions; // Phi nodes first, the terminator last
+    std::vector<BasicBlock *> predecessors, successors;
+    bool sealed = false;
+
+    std::string getName() const { return fmt::format("bb{}", id); }
+};
+
+struct Function {
+    std::string name;
+    std::vector<std::shared_ptr<Slot>> slots;
+    std::vector<std::unique_ptr<BasicBlock>> blocks;
+    std::list<std::unique_ptr<Instruction>> instructions;
+
+    // The value each AST expression evaluates to
+    std::map<const AST::Expression *, Instruction *> values;
+
+    void printTo(std::ostream &stream) const {
+        stream << "function " << name << std::endl;
+        for (auto &slot : slots) {
+            stream << fmt::format("  slot {}: {}{}{}", slot->name, getTypeName(slot->type),
+                                  slot->isReference ? ", reference" : slot->isParameter ? ", parameter" : "",
+                                  slot->promotable ? ", ssa" : "") << std::endl;
+        }
+        for (auto &block : blocks) {
+            stream << block->getName() << ":";
+            if (!block->predecessors.empty()) {
+                stream << " ; preds";
+                for (auto pred : block->predecessors) stream << " " << pred->getName();
+            }
+            stream << std::endl;
+            for (auto instruction : block->instructions) stream << "  " << toString(instruction) << std::endl;
+        }
+    }
+
+    // Describes the first use of a value not placed in any block of the function, if there is one
+    std::optional<std::string> findUndefinedOperand() const {
+        std::set<const Instruction *> placed;
+        for (auto &block : blocks) placed.insert(block->instructions.begin(), block->instructions.end());
+        for (auto &block : blocks) {
+            for (auto instruction : block->instructions) {
+                for (auto operand : instruction->operands) {
+                    if (placed.count(operand)) continue;
+                    return fmt::format("{}: {} uses {}, which is never defined", block->getName(), toString(instruction),
+                                       operand ? operand->getName() : "null");
+                }
+            }
+        }
+        for (auto &[expr, value] : values) {
+            if (!placed.count(value)) return fmt::format("an expression evaluates to {}, which is never defined", value->getName());
+        }
+        return std::nullopt;
+    }
+
+    static std::string toString(const Instruction *instruction) {
+        std::string result;
+        if (instruction->type != Type::Void) result = fmt::format("{} = {} ", instruction->getName(), getTypeName(instruction->type));
+
+        switch (instruction->opcode) {
+            case Opcode::Constant: result += "const " + instruction->name; break;
+            case Opcode::Parameter: result += "param " + instruction->slot->name; break;
+            case Opcode::Undefined: result += "undef"; break;
+            case Opcode::LoadSlot: result += "load.slot " + instruction->slot->name; break;
+            case Opcode::StoreSlot: result += "store.slot " + instruction->slot->name + ","; break;
+            case Opcode::Address: result += "addr" + (instruction->slot ? " " + instruction->slot->name : instruction->name.empty() ? "" : " ." + instruction->name); break;
+            case Opcode::Load: result += "load"; break;
+            case Opcode::Store: result += "store"; break;
+            case Opcode::Binary: result += AST::getBinaryOperatorName(instruction->binaryOperator); break;
+            case Opcode::Unary: result += AST::getUnaryOperatorName(instruction->unaryOperator); break;
+            case Opcode::IntegerToDouble: result += "itod"; break;
+            case Opcode::DoubleToInteger: result += "dtoi"; break;
+            case Opcode::Call: result += "call " + instruction->name; break;
+            case Opcode::Phi: result += "phi"; break;
+            case Opcode::Jump: result += "jmp"; break;
+            case Opcode::Branch: result += "br"; break;
+            case Opcode::Return: result += "ret"; break;
+        }
+
+        for (size_t i = 0; i < instruction->operands.size(); i++) {
+            result += (i ? ", " : " ") + instruction->operands[i]->getName();
+            if (instruction->opcode == Opcode::Phi) result += " from " + instruction->block->predecessors[i]->getName();
+        }
+        for (size_t i = 0; i < instruction->targets.size(); i++)
+            result += ((i || !instruction->operands.empty()) ? ", " : " ") + instruction->targets[i]->getName();
+        return result;
+    }
+};
+
+// What a name means where the function being lowered uses it
+struct Name {
+    enum class Kind { Unresolved, Variable, Constant, Callable } kind = Kind::Unresolved;
+    std::shared_ptr<Slot> slot;
+    std::string literal;
+    Signature signature;
+    bool isCurrentFunction = false; // Assigning to it sets the result
+};
+
+// Given by the codegen, which keeps the only symbol tables
+class Resolver {
+public:
+    virtual ~Resolver() = default;
+    virtual Name resolveName(const std::string &name) = 0;
+    // The type of a member or element of a variable
+    virtual Type getLoadType(std::shared_ptr<AST::MaybeLeftValueExpression> expr) = 0;
+};
+
+// Lowers the AST to SSA form with the on-the-fly construction of Braun et al.
+class Builder {
+    Resolver &resolver;
+
+    // The function being lowered
+    Function *function;
+    BasicBlock *current;
+    std::shared_ptr<Slot> resultSlot;
+    std::map<Slot *, std::map<BasicBlock *, Instruction *>> currentDefinitions;
+    std::map<BasicBlock *, std::map<Slot *, Instruction *>> incompletePhis;
+    // Removed trivial phis, forwarded to the value replacing them
+    std::map<Instruction *, Instruction *> replacements;
+
+    static Type getLiteralType(const std::string &literal) {
+        if (literal.empty() || literal[0] == '\'') return Type::Other;
+        if (literal.find(".") == std::string::npos && literal.find("e") == std::string::npos) return Type::Integer;
+        return Type::Double;
+    }
+
+    // Construction of instructions and blocks
+    BasicBlock *newBlock() {
+        function->blocks.push_back(std::make_unique<BasicBlock>());
+        function->blocks.back()->id = function->blocks.size() - 1;
+        return function->blocks.back().get();
+    }
+
+    Instruction *newInstruction(Opcode opcode, Type type, std::vector<Instruction *> operands = {}) {
+        auto instruction = std::make_unique<Instruction>();
+        instruction->id = function->instructions.size();
+        instruction->opcode = opcode;
+        instruction->type = type;
+        instruction->operands = std::move(operands);
+        function->instructions.push_back(std::move(instruction));
+        return function->instructions.back().get();
+    }
+
+    Instruction *emit(Opcode opcode, Type type, std::vector<Instruction *> operands = {}) {
+        for (auto &operand : operands) operand = resolve(operand);
+        auto instruction = newInstruction(opcode, type, std::move(operands));
+        instruction->block = current;
+        current->instructions.push_back(instruction);
+        return instruction;
+    }
+
+    Instruction *emitConstant(const std::string &literal) {
+        auto instruction = emit(Opcode::Constant, getLiteralType(literal));
+        instruction->name = literal;
+        return instruction;
+    }
+
+    void addEdge(BasicBlock *from, BasicBlock *to) {
+        from->successors.push_back(to);
+        to->predecessors.push_back(from);
+    }
+
+    void jump(BasicBlock *to) {
+        emit(Opcode::Jump, Type::Void)->targets = {to};
+        addEdge(current, to);
+    }
+
+    void branch(Instruction *condition, BasicBlock *ifTrue, BasicBlock *ifFalse) {
+        emit(Opcode::Branch, Type::Void, {condition})->targets = {ifTrue, ifFalse};
+        addEdge(current, ifTrue);
+        addEdge(current, ifFalse);
+    }
+
+    // SSA construction
+    Instruction *resolve(Instruction *value) {
+        for (auto it = replacements.find(value); it != replacements.end(); it = replacements.find(value)) value = it->second;
+        return value;
+    }
+
+    void writeVariable(Slot *slot, BasicBlock *block, Instruction *value) {
+        currentDefinitions[slot][block] = resolve(value);
+    }
+
+    Instruction *readVariable(Slot *slot, BasicBlock *block) {
+        auto &definitions = currentDefinitions[slot];
+        if (auto it = definitions.find(block); it != definitions.end()) return it->second = resolve(it->second);
+
+        Instruction *value;
+        if (!block->sealed) {
+            value = newPhi(slot, block);
+            incompletePhis[block][slot] = value;
+        } else if (block->predecessors.size() == 1) {
+            value = readVariable(slot, block->predecessors[0]);
+        } else {
+            auto phi = newPhi(slot, block);
+            writeVariable(slot, block, phi);
+            value = addPhiOperands(slot, phi);
+        }
+        // Removing a trivial phi may have removed the value it was replaced by too
+        value = resolve(value);
+        writeVariable(slot, block, value);
+        return value;
+    }
+
+    Instruction *newPhi(Slot *slot, BasicBlock *block) {
+        auto phi = newInstruction(Opcode::Phi, slot->type);
+        phi->block = block;
+        block->instructions.push_front(phi);
+        return phi;
+    }
+
+    Instruction *addPhiOperands(Slot *slot, Instruction *phi) {
+        for (auto pred : phi->block->predecessors) phi->operands.push_back(readVariable(slot, pred));
+        // Reading an operand may have already replaced a phi it depends on
+        for (auto &operand : phi->operands) operand = resolve(operand);
+        return tryRemoveTrivialPhi(phi);
+    }
+
+    Instruction *tryRemoveTrivialPhi(Instruction *phi) {
+        Instruction *same = nullptr;
+        for (auto operand : phi->operands) {
+            if (operand == same || operand == phi) continue;
+            if (same) return phi;
+            same = operand;
+        }
+        if (!same) return phi; // Unreachable, keep the phi without operands
+
+        std::vector<Instruction *> users;
+        for (auto &instruction : function->instructions) {
+            if (instruction.get() == phi || instruction->removed) continue;
+            for (auto &operand : instruction->operands) {
+                if (operand != phi) continue;
+                operand = same;
+                if (instruction->opcode == Opcode::Phi) users.push_back(instruction.get());
+            }
+        }
+        for (auto &[slot, definitions] : currentDefinitions) {
+            for (auto &[block, value] : definitions) if (value == phi) value = same;
+        }
+        for (auto &[expr, value] : function->values) if (value == phi) value = same;
+
+        phi->removed = true;
+        phi->block->instructions.remove(phi);
+        replacements[phi] = same;
+
+        for (auto user : users) if (!user->removed) tryRemoveTrivialPhi(user);
+        return resolve(same);
+    }
+
+    void sealBlock(BasicBlock *block) {
+        for (auto [slot, phi] : incompletePhis[block]) {
+            if (!phi->removed) addPhiOperands(slot, phi);
+        }
+        incompletePhis.erase(block);
+        block->sealed = true;
+    }
+
+    // Conversions between integers and doubles, as the codegen's ensureType
+    Instruction *convert(Instruction *value, Type type) {
+        if (value->type == Type::Integer && type == Type::Double) return emit(Opcode::IntegerToDouble, Type::Double, {value});
+        if (value->type == Type::Double && type == Type::Integer) return emit(Opcode::DoubleToInteger, Type::Integer, {value});
+        return value;
+    }
+
+    Instruction *readSlot(std::shared_ptr<Slot> slot) {
+        if (slot->promotable) return readVariable(slot.get(), current);
+        auto load = emit(Opcode::LoadSlot, slot->type);
+        load->slot = slot;
+        return load;
+    }
+
+    void writeSlot(std::shared_ptr<Slot> slot, Instruction *value) {
+        value = convert(value, slot->type);
+        if (slot->promotable) {
+            writeVariable(slot.get(), current, value);
+        } else {
+            emit(Opcode::StoreSlot, Type::Void, {value})->slot = slot;
+        }
+    }
+
+    Instruction *lowerCall(const std::string &name, const std::list<std::shared_ptr<AST::Expression>> &arguments) {
+        auto callee = resolver.resolveName(name);
+        bool isCallable = callee.kind == Name::Kind::Callable;
+        auto &byReference = callee.signature.byReference;
+        std::vector<Instruction *> operands;
+        size_t i = 0;
+        for (auto argument : arguments) {
+            if (isCallable && i < byReference.size() && byReference[i])
+                operands.push_back(lowerAddress(argument));
+            else
+                operands.push_back(lowerExpression(argument));
+            i++;
+        }
+        auto call = emit(Opcode::Call, isCallable ? callee.signature.returnType : Type::Other, std::move(operands));
+        call->name = name;
+        return call;
+    }
+
+    Instruction *lowerAddress(std::shared_ptr<AST::Expression> expr) {
+        if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto name = resolver.resolveName(ex->identifier);
+            if (name.kind != Name::Kind::Variable) return lowerExpression(expr);
+            auto address = emit(Opcode::Address, Type::Other);
+            address->slot = name.slot;
+            return address;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::RecordAccessExpression>(expr)) {
+            auto address = emit(Opcode::Address, Type::Other, {lowerAddress(ex->record)});
+            address->name = ex->member;
+            return address;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::ArrayAccessExpression>(expr)) {
+            std::vector<Instruction *> operands;
+            for (auto index : ex->indexes) operands.push_back(convert(lowerExpression(index), Type::Integer));
+            operands.insert(operands.begin(), lowerAddress(ex->array));
+            return emit(Opcode::Address, Type::Other, std::move(operands));
+        } else if (auto ex = std::dynamic_pointer_cast<AST::PointerAccessExpression>(expr)) {
+            return emit(Opcode::Address, Type::Other, {lowerExpression(ex->pointer)});
+        }
+        return lowerExpression(expr);
+    }
+
+    Instruction *lowerExpression(std::shared_ptr<AST::Expression> expr) {
+        auto value = lowerExpressionValue(expr);
+        function->values[expr.get()] = value;
+        return value;
+    }
+
+    Instruction *lowerExpressionValue(std::shared_ptr<AST::Expression> expr) {
+        if (auto ex = std::dynamic_pointer_cast<AST::ConstantExpression>(expr)) {
+            return emitConstant(ex->value);
+        } else if (auto ex = std::dynamic_pointer_cast<AST::IdentifierExpression>(expr)) {
+            auto name = resolver.resolveName(ex->identifier);
+            switch (name.kind) {
+                case Name::Kind::Variable: return readSlot(name.slot);
+                case Name::Kind::Constant: return emitConstant(name.literal);
+                case Name::Kind::Callable: return lowerCall(ex->identifier, {});
+                default: return emit(Opcode::Undefined, Type::Other);
+            }
+        } else if (auto ex = std::dynamic_pointer_cast<AST::MaybeLeftValueExpression>(expr)) {
+            auto address = lowerAddress(ex);
+            return emit(Opcode::Load, resolver.getLoadType(ex), {address});
+        } else if (auto ex = std::dynamic_pointer_cast<AST::BinaryOperatorExpression>(expr)) {
+            auto left = lowerExpression(ex->leftOperand), right = lowerExpression(ex->rightOperand);
+            auto isNumber = [](Instruction *value) { return value->type == Type::Integer || value->type == Type::Double; };
+            Type type = Type::Other;
+
+            if (ex->op <= AST::BinaryOperator::Slash) {
+                if (isNumber(left) && isNumber(right)) {
+                    bool useDouble = left->type == Type::Double || right->type == Type::Double || ex->op == AST::BinaryOperator::Slash;
+                    if (useDouble) {
+                        left = convert(left, Type::Double);
+                        right = convert(right, Type::Double);
+                    }
+                    type = ex->op < AST::BinaryOperator::Plus ? Type::Integer : useDouble ? Type::Double : Type::Integer;
+                }
+            } else {
+                left = convert(left, Type::Integer);
+                right = convert(right, Type::Integer);
+                type = Type::Integer;
+            }
+
+            auto instruction = emit(Opcode::Binary, type, {left, right});
+            instruction->binaryOperator = ex->op;
+            return instruction;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::UnaryOperatorExpression>(expr)) {
+            if (ex->op == AST::UnaryOperator::At) return lowerAddress(ex->operand);
+            auto operand = lowerExpression(ex->operand);
+            auto instruction = emit(Opcode::Unary, ex->op == AST::UnaryOperator::Not ? Type::Integer : operand->type, {operand});
+            instruction->unaryOperator = ex->op;
+            return instruction;
+        } else if (auto ex = std::dynamic_pointer_cast<AST::CallExpressionWithArguments>(expr)) {
+            return lowerCall(ex->functionName, ex->argumentList);
+        }
+        return emit(Opcode::Undefined, Type::Other);
+    }
+
+    void lowerStatement(std::shared_ptr<AST::Statement> stmt) {
+        if (auto st = std::dynamic_pointer_cast<AST::AssignmentStatement>(stmt)) {
+            auto value = lowerExpression(st->right);
+            if (auto lv = std::dynamic_pointer_cast<AST::IdentifierExpression>(st->left)) {
+                auto name = resolver.resolveName(lv->identifier);
+                if (name.isCurrentFunction && resultSlot) {
+                    // Return value assignment
+                    writeSlot(resultSlot, value);
+                } else if (name.kind == Name::Kind::Variable) {
+                    writeSlot(name.slot, value);
+                }
+            } else {
+                emit(Opcode::Store, Type::Void, {lowerAddress(st->left), value});
+            }
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExplicitCallStatement>(stmt)) {
+            lowerCall(st->functionName, {});
+        } else if (auto st = std::dynamic_pointer_cast<AST::CompoundStatement>(stmt)) {
+            for (auto sub : st->statements) lowerStatement(sub);
+        } else if (auto st = std::dynamic_pointer_cast<AST::WhileStatement>(stmt)) {
+            auto header = newBlock(), body = newBlock(), exit = newBlock();
+            jump(header);
+
+            current = header;
+            branch(lowerExpression(st->condition), body, exit);
+
+            sealBlock(body);
+            current = body;
+            lowerStatement(st->statement);
+            jump(header);
+
+            sealBlock(header);
+            sealBlock(exit);
+            current = exit;
+        } else if (auto st = std::dynamic_pointer_cast<AST::RepeatStatement>(stmt)) {
+            auto body = newBlock(), exit = newBlock();
+            jump(body);
+
+            current = body;
+            lowerStatement(st->statement);
+            branch(lowerExpression(st->condition), exit, body);
+
+            sealBlock(body);
+            sealBlock(exit);
+            current = exit;
+        } else if (auto st = std::dynamic_pointer_cast<AST::ForStatement>(stmt)) {
+            auto name = resolver.resolveName(st->variable);
+            if (name.kind != Name::Kind::Variable) return; // Rejected by the codegen
+            auto slot = name.slot;
+
+            writeSlot(slot, lowerExpression(st->initialValue));
+            auto finalValue = convert(lowerExpression(st->finalValue), Type::Integer);
+
+            auto header = newBlock(), body = newBlock(), exit = newBlock();
+            jump(header);
+
+            current = header;
+            bool up = st->direction == AST::ForStatement::Direction::Up;
+            auto compare = emit(Opcode::Binary, Type::Integer, {readSlot(slot), finalValue});
+            compare->binaryOperator = up ? AST::BinaryOperator::GreaterThan : AST::BinaryOperator::LessThan;
+            branch(compare, exit, body);
+
+            sealBlock(body);
+            current = body;
+            lowerStatement(st->statement);
+            auto step = emit(Opcode::Binary, Type::Integer, {readSlot(slot), emitConstant("1")});
+            step->binaryOperator = up ? AST::BinaryOperator::Plus : AST::BinaryOperator::Minus;
+            writeSlot(slot, step);
+            jump(header);
+
+            sealBlock(header);
+            sealBlock(exit);
+            current = exit;
+        } else if (auto st = std::dynamic_pointer_cast<AST::IfStatement>(stmt)) {
+            auto ifTrue = newBlock(), ifFalse = newBlock(), exit = newBlock();
+            branch(lowerExpression(st->condition), ifTrue, ifFalse);
+            sealBlock(ifTrue);
+            sealBlock(ifFalse);
+
+            current = ifTrue;
+            lowerStatement(st->statementForTrue);
+            jump(exit);
+
+            current = ifFalse;
+            lowerStatement(st->statementForFalse);
+            jump(exit);
+
+            sealBlock(exit);
+            current = exit;
+        } else if (auto st = std::dynamic_pointer_cast<AST::ExpressionStatement>(stmt)) {
+            lowerExpression(st->expression);
+        }
+    }
+
+public:
+    Builder(Resolver &resolver) : resolver(resolver) {}
+
+    // The slots are the function's variables and parameters, and its result if it has one
+    std::unique_ptr<Function> build(const std::string &name, std::shared_ptr<AST::Block> astBlock,
+                                    std::vector<std::shared_ptr<Slot>> slots, std::shared_ptr<Slot> resultSlot) {
+        auto result = std::make_unique<Function>();
+        function = result.get();
+        currentDefinitions.clear();
+        incompletePhis.clear();
+        replacements.clear();
+
+        function->name = name;
+        function->slots = std::move(slots);
+        this->resultSlot = resultSlot;
+        if (resultSlot) function->slots.push_back(resultSlot);
+
+        current = newBlock();
+        sealBlock(current);
+
+        // Local variables are zero-initialized
+        for (auto slot : function->slots) {
+            if (!slot->promotable) continue;
+            if (slot->isParameter) {
+                auto parameter = emit(Opcode::Parameter, slot->type);
+                parameter->slot = slot;
+                writeVariable(slot.get(), current, parameter);
+            } else {
+                writeVariable(slot.get(), current, emitConstant(slot->type == Type::Double ? "0.0" : "0"));
+            }
+        }
+
+        lowerStatement(astBlock->statement);
+        emit(Opcode::Return, Type::Void);
+
+        // Forward any use still holding a removed phi
+        for (auto &instruction : function->instructions) {
+            for (auto &operand : instruction->operands) operand = resolve(operand);
+        }
+        for (auto &[expr, value] : function->values) value = resolve(value);
+        return result;
+    }
+};
+
+// Sparse conditional constant propagation of Wegman and Zadeck
+class ConstantPropagation {
+    using Value = AST::ConstantFolder::Value;
+
+    struct Lattice {
+        enum class State { Top, Constant, Bottom } state = State::Top;
+        Value value;
+
+        bool operator==(const Lattice &other) const {
+            if (state != other.state) return false;
+            if (state != State::Constant) return true;
+            return isSameValue(value, other.value);
+        }
+    };
+
+    static bool isSameValue(const Value &a, const Value &b) {
+        if (a.isDouble != b.isDouble) return false;
+        if (!a.isDouble) return a.integer == b.integer;
+        return std::memcmp(&a.real, &b.real, sizeof(double)) == 0;
+    }
+
+    static Lattice bottom() { return {Lattice::State::Bottom, {}}; }
+    static Lattice constant(const Value &value) { return {Lattice::State::Constant, value}; }
+
+    static Lattice meet(const Lattice &a, const Lattice &b) {
+        if (a.state == Lattice::State::Top) return b;
+        if (b.state == Lattice::State::Top) return a;
+        if (a.state == Lattice::State::Bottom || b.state == Lattice::State::Bottom) return bottom();
+        return isSameValue(a.value, b.value) ? a : bottom();
+    }
+
+    std::map<const Instruction *, Lattice> lattice;
+    std::set<std::pair<const BasicBlock *, const BasicBlock *>> executableEdges;
+    std::set<const BasicBlock *> executableBlocks;
+    std::map<const Instruction *, std::vector<Instruction *>> users;
+    std::vector<std::pair<const BasicBlock *, BasicBlock *>> flowWorklist;
+    std::vector<Instruction *> ssaWorklist;
+
+    Lattice evaluate(const Instruction *instruction) {
+        switch (instruction->opcode) {
+            case Opcode::Constant:
+                if (auto value = AST::ConstantFolder::parseLiteral(instruction->name)) return constant(*value);
+                return bottom();
+            case Opcode::Phi: {
+                Lattice result;
+                auto &preds = instruction->block->predecessors;
+                for (size_t i = 0; i < instruction->operands.size(); i++) {
+                    if (executableEdges.count({preds[i], instruction->block})) result = meet(result, lattice[instruction->operands[i]]);
+                }
+                return result;
+            }
+            case Opcode::Binary:
+            case Opcode::Unary:
+            case Opcode::IntegerToDouble:
+            case Opcode::DoubleToInteger: {
+                std::vector<Value> values;
+                for (auto operand : instruction->operands) {
+                    auto &x = lattice[operand];
+                    if (x.state == Lattice::State::Bottom) return bottom();
+                    if (x.state == Lattice::State::Top) return {};
+                    values.push_back(x.value);
+                }
+
+                std::optional<Value> result;
+                if (instruction->opcode == Opcode::Binary)
+                    result = AST::ConstantFolder::evaluate(instruction->binaryOperator, values[0], values[1]);
+                else if (instruction->opcode == Opcode::Unary)
+                    result = AST::ConstantFolder::evaluate(instruction->unaryOperator, values[0]);
+                else if (instruction->opcode == Opcode::IntegerToDouble)
+                    result = Value::fromDouble(values[0].toDouble());
+                else if (auto integer = values[0].toInteger())
+                    result = Value::fromInteger(*integer);
+                return result ? constant(*result) : bottom();
+            }
+            default:
+                return bottom();
+        }
+    }
+
+    void markEdge(const BasicBlock *from, BasicBlock *to) {
+        if (!executableEdges.count({from, to})) flowWorklist.push_back({from, to});
+    }
+
+    void visit(Instruction *instruction) {
+        if (instruction->opcode == Opcode::Jump) {
+            markEdge(instruction->block, instruction->targets[0]);
+            return;
+        }
+        if (instruction->opcode == Opcode::Branch) {
+            auto &condition = lattice[instruction->operands[0]];
+            if (condition.state == Lattice::State::Bottom) {
+                markEdge(instruction->block, instruction->targets[0]);
+                markEdge(instruction->block, instruction->targets[1]);
+            } else if (condition.state == Lattice::State::Constant) {
+                bool taken = condition.value.isDouble ? condition.value.real != 0 : condition.value.integer != 0;
+                markEdge(instruction->block, instruction->targets[taken ? 0 : 1]);
+            }
+            return;
+        }
+
+        auto result = evaluate(instruction);
+        if (result == lattice[instruction]) return;
+        lattice[instruction] = result;
+        for (auto user : users[instruction]) ssaWorklist.push_back(user);
+    }
+
+public:
+    // The AST expressions known to evaluate to a constant, with their values as literals
+    std::map<const AST::Expression *, std::string> constants;
+
+    void run(const Function &function) {
+        lattice.clear();
+        executableEdges.clear();
+        executableBlocks.clear();
+        users.clear();
+
+        for (auto &block : function.blocks) {
+            for (auto instruction : block->instructions)
+                for (auto operand : instruction->operands) users[operand].push_back(instruction);
+        }
+
+        flowWorklist.push_back({nullptr, function.blocks[0].get()});
+        while (!flowWorklist.empty() || !ssaWorklist.empty()) {
+            while (!flowWorklist.empty()) {
+                auto [from, to] = flowWorklist.back();
+                flowWorklist.pop_back();
+                if (!executableEdges.insert({from, to}).second) continue;
+
+                bool first = executableBlocks.insert(to).second;
+                for (auto instruction : to->instructions) {
+                    if (first || instruction->opcode == Opcode::Phi) visit(instruction);
+                }
+            }
+            while (!ssaWorklist.empty()) {
+                auto instruction = ssaWorklist.back();
+                ssaWorklist.pop_back();
+                if (executableBlocks.count(instruction->block)) visit(instruction);
+            }
+        }
+
+        for (auto [expr, value] : function.values) {
+            auto &x = lattice[value];
+            if (x.state == Lattice::State::Constant) constants[expr] = AST::ConstantFolder::formatLiteral(x.value);
+        }
+    }
+
+    std::optional<std::string> getConstant(const AST::Expression *expr) const {
+        if (auto it = constants.find(expr); it != constants.end()) return it->second;
+        return std::nullopt;
+    }
+};
+
+}
+
+#endif // _MENCI_IR_H
@@ -2,6 +2,7 @@
 
 #include "context.h"
 #include "ast-print.h"
+#include "ast-fold.h"
 #include "codegen.h"
 
 int main(int argc, char *argv[]) {
@@ -11,6 +12,50 @@ int main(int argc, char *argv[]) {
             ctx.traceParsing = true;
         } else if (argv[i] == std::string("-s")) {
             ctx.traceScanning = true;
+        } else if (argv[i] == std::string("--no-peephole")) {
+            CodeGen::options.peephole = false;
+        } else if (argv[i] == std::string("--peephole-stats")) {
+            CodeGen::options.peepholeStatistics = true;
+        } else if (argv[i] == std::string("--dump-ir")) {
+            CodeGen::options.dumpIR = true;
+        } else if (argv[i] == std::string("--no-sccp")) {
+            CodeGen::options.constantPropagation = false;
+        } else if (argv[i] == std::string("--static-link")) {
+            CodeGen::options.nonLocalAccess = CodeGen::NonLocalAccess::StaticLink;
+        } else if (argv[i] == std::string("--display")) {
+            CodeGen::options.nonLocalAccess = CodeGen::NonLocalAccess::Display;
+        } else if (argv[i] == std::string("--no-bounds-check")) {
+            CodeGen::options.boundsCheck = false;
+        } else if (argv[i] == std::string("--no-inline")) {
+            CodeGen::options.inlining = false;
+        } else if (argv[i] == std::string("--inline-report")) {
+            CodeGen::options.inliningReport = true;
+        } else if (argv[i] == std::string("--no-tail-calls")) {
+            CodeGen::options.tailCalls = false;
+        } else if (argv[i] == std::string("--no-induction-pointers")) {
+            CodeGen::options.inductionPointers = false;
+        } else if (argv[i] == std::string("--no-licm")) {
+            CodeGen::options.loopInvariantMotion = false;
+        } else if (argv[i] == std::string("--no-cse")) {
+            CodeGen::options.commonSubexpressions = false;
+        } else if (argv[i] == std::string("--cse-report")) {
+            CodeGen::options.commonSubexpressionsReport = true;
+        } else if (argv[i] == std::string("--no-short-circuit")) {
+            CodeGen::options.shortCircuit = false;
+        } else if (argv[i] == std::string("--no-strength-reduction")) {
+            CodeGen::options.strengthReduction = false;
+        } else if (argv[i] == std::string("--no-vectorize")) {
+            CodeGen::options.vectorization = false;
+        } else if (argv[i] == std::string("-march=x86-64") || argv[i] == std::string("-march=sse2")) {
+            CodeGen::options.instructionSet = CodeGen::InstructionSet::SSE2;
+        } else if (argv[i] == std::string("-march=avx2")) {
+            CodeGen::options.instructionSet = CodeGen::InstructionSet::AVX2;
+        } else if (argv[i] == std::string("--no-dead-function-elimination")) {
+            CodeGen::options.deadFunctionElimination = false;
+        } else if (argv[i] == std::string("--no-register-arguments")) {
+            CodeGen::options.registerArguments = false;
+        } else if (argv[i] == std::string("--no-frame-omission")) {
+            CodeGen::options.frameOmission = false;
         } else {
             ctx.parse(argv[i]);
 
@@ -19,6 +64,7 @@ int main(int argc, char *argv[]) {
                 stream.print(ctx.program);
             }
 
+            AST::ConstantFolder().fold(ctx.program);
             std::cout << CodeGen::generateCode(ctx.program->topLevelBlock);
         }
     }
@@ -615,6 +615,12 @@ OperatorExpression
   | OperatorExpression O_SHR   OperatorExpression
     { if (ctx.printReduceRule) std::cerr << "OperatorExpression => OperatorExpression O_SHR   OperatorExpression" << std::endl;
       $$ = std::make_shared<AST::BinaryOperatorExpression>($1, AST::BinaryOperator::RightShift, $3); }
+  | OperatorExpression O_AND K_THEN OperatorExpression %prec O_AND
+    { if (ctx.printReduceRule) std::cerr << "OperatorExpression => OperatorExpression O_AND K_THEN OperatorExpression" << std::endl;
+      $$ = std::make_shared<AST::BinaryOperatorExpression>($1, AST::BinaryOperator::AndThen, $4); }
+  | OperatorExpression O_OR K_ELSE OperatorExpression %prec O_OR
+    { if (ctx.printReduceRule) std::cerr << "OperatorExpression => OperatorExpression O_OR K_ELSE OperatorExpression" << std::endl;
+      $$ = std::make_shared<AST::BinaryOperatorExpression>($1, AST::BinaryOperator::OrElse, $4); }
 %type <std::shared_ptr<AST::Expression>> UnaryOperatorExpression;
 UnaryOperatorExpression
   :         NonOperatorExpression
@@ -0,0 +1,565 @@
+#ifndef _MENCI_PEEPHOLE_H
+#define _MENCI_PEEPHOLE_H
+
+#include <string>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <cerrno>
+#include <cstdlib>
+#include <ostream>
+#include <fmt/format.h>
+
+namespace CodeGen {
+
+// The 64-bit register a register name is a part of, the name itself for XMM registers,
+// or empty if it's not a register
+std::string getRegisterFamily(const std::string &name) {
+    static const std::map<std::string, std::string> families = [] {
+        std::map<std::string, std::string> result;
+        for (auto [family, aliases] : std::vector<std::pair<std::string, std::vector<std::string>>>{
+            {"rax", {"eax", "ax", "al", "ah"}},
+            {"rbx", {"ebx", "bx", "bl", "bh"}},
+            {"rcx", {"ecx", "cx", "cl", "ch"}},
+            {"rdx", {"edx", "dx", "dl", "dh"}},
+            {"rsi", {"esi", "si", "sil"}},
+            {"rdi", {"edi", "di", "dil"}},
+            {"rbp", {"ebp", "bp", "bpl"}},
+            {"rsp", {"esp", "sp", "spl"}}
+        }) {
+            result[family] = family;
+            for (auto alias : aliases) result[alias] = family;
+        }
+        for (int i = 8; i < 16; i++) {
+            auto family = "r" + std::to_string(i);
+            for (auto suffix : {"", "d", "w", "b"}) result[family + suffix] = family;
+        }
+        for (int i = 0; i < 16; i++) result["xmm" + std::to_string(i)] = "xmm" + std::to_string(i);
+        return result;
+    }();
+
+    auto it = families.find(name);
+    return it == families.end() ? "" : it->second;
+}
+
+// One line of assembly, either a label or an instruction
+struct AssemblyLine {
+    std::string label;
+    std::string op;
+    std::vector<std::string> operands;
+    bool deleted = false;
+
+    static AssemblyLine parse(const std::string &line) {
+        AssemblyLine result;
+        if (line.back() == ':' && line[0] != ' ') {
+            result.label = line.substr(0, line.size() - 1);
+            return result;
+        }
+
+        auto begin = line.find_first_not_of(' ');
+        auto end = line.find(' ', begin);
+        result.op = line.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+        while (end != std::string::npos) {
+            begin = end + 1;
+            end = line.find(", ", begin);
+            result.operands.push_back(line.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+            if (end != std::string::npos) end++;
+        }
+        return result;
+    }
+
+    std::string toString() const {
+        if (isLabel()) return label + ":";
+
+        std::string result = "    " + op;
+        for (size_t i = 0; i < operands.size(); i++) result += (i ? ", " : " ") + operands[i];
+        return result;
+    }
+
+    bool isLabel() const { return !label.empty(); }
+    bool isJump() const { return !op.empty() && op[0] == 'j'; }
+    bool isUnconditionalJump() const { return op == "jmp"; }
+};
+
+// Rewrites the generated assembly with a table of pattern-driven rules, until none of them applies.
+//
+// It relies on rax, rcx and rdx being scratch registers of the code generator: they are never live
+// across a label, a jump, or a call to a non-builtin function.
+class PeepholeOptimizer {
+    struct Rule {
+        const char *name;
+        size_t (PeepholeOptimizer::*apply)(std::vector<AssemblyLine> &lines);
+        size_t hits = 0;
+    };
+
+    std::vector<Rule> rules = {
+        {"remove-nop", &PeepholeOptimizer::ruleRemoveNop},
+        {"zero-stack-adjustment", &PeepholeOptimizer::ruleZeroStackAdjustment},
+        {"self-move", &PeepholeOptimizer::ruleSelfMove},
+        {"push-pop", &PeepholeOptimizer::rulePushPop},
+        {"overwritten-move", &PeepholeOptimizer::ruleOverwrittenMove},
+        {"fold-index-immediate", &PeepholeOptimizer::ruleFoldIndexImmediate},
+        {"store-load-forwarding", &PeepholeOptimizer::ruleStoreLoadForwarding},
+        {"redundant-load", &PeepholeOptimizer::ruleRedundantLoad},
+        {"jump-to-next", &PeepholeOptimizer::ruleJumpToNext},
+        {"invert-branch", &PeepholeOptimizer::ruleInvertBranch},
+        {"unreachable-code", &PeepholeOptimizer::ruleUnreachableCode},
+        {"unused-label", &PeepholeOptimizer::ruleUnusedLabel}
+    };
+
+    // Labels referenced from outside of the optimized code
+    std::set<std::string> entryLabels;
+
+    static bool isMemory(const std::string &operand) {
+        return operand.find('[') != std::string::npos;
+    }
+
+    static bool isImmediate(const std::string &operand) {
+        if (operand.empty()) return false;
+        char *end;
+        errno = 0;
+        std::strtoll(operand.c_str(), &end, 10);
+        return !*end && !errno;
+    }
+
+    // A 64-bit general-purpose register, or an XMM register
+    static bool isFullRegister(const std::string &operand) {
+        return getRegisterFamily(operand) == operand;
+    }
+
+    static bool isScratchRegister(const std::string &reg) {
+        return reg == "rax" || reg == "rcx" || reg == "rdx";
+    }
+
+    static std::vector<std::string> getTokens(const std::string &operand) {
+        std::vector<std::string> tokens;
+        std::string token;
+        for (char c : operand) {
+            if (isalnum(c) || c == '_' || c == '.' || c == '$') token += c;
+            else if (!token.empty()) tokens.push_back(std::move(token)), token.clear();
+        }
+        if (!token.empty()) tokens.push_back(std::move(token));
+        return tokens;
+    }
+
+    static bool mentions(const std::string &operand, const std::string &family) {
+        for (auto &token : getTokens(operand))
+            if (getRegisterFamily(token) == family) return true;
+        return false;
+    }
+
+    static bool mentions(const AssemblyLine &line, const std::string &family) {
+        for (auto &operand : line.operands)
+            if (mentions(operand, family)) return true;
+        return false;
+    }
+
+    // Instructions which only write their first operand
+    static bool isPureWrite(const std::string &op) {
+        static const std::set<std::string> ops = {
+            "mov", "movzx", "movsx", "lea", "movq", "movapd", "cvttsd2si"
+        };
+        return ops.count(op);
+    }
+
+    // Instructions which read and write their first operand, and read the others
+    static bool isReadModifyWrite(const std::string &op) {
+        static const std::set<std::string> ops = {
+            "add", "sub", "and", "or", "xor", "shl", "shr", "sar", "inc", "dec", "neg", "not",
+            "movsd", "cvtsi2sd", "addsd", "subsd", "mulsd", "divsd", "xorpd", "andpd",
+            "cmpeqsd", "cmpneqsd", "cmpltsd", "cmplesd", "cmpnltsd", "cmpnlesd"
+        };
+        return ops.count(op) || op.compare(0, 3, "set") == 0;
+    }
+
+    // Registers written by an instruction, plus whether it writes memory.
+    // Returns false if the effects are unknown.
+    static bool getEffects(const AssemblyLine &line, std::set<std::string> &registers, bool &writesMemory) {
+        auto &op = line.op;
+        writesMemory = false;
+        auto writeOperand = [&](const std::string &operand) {
+            if (isMemory(operand)) writesMemory = true;
+            else registers.insert(getRegisterFamily(operand));
+        };
+
+        if (op == "imul" && line.operands.size() == 1) {
+            registers.insert("rax");
+            registers.insert("rdx");
+        } else if (isPureWrite(op) || isReadModifyWrite(op) || op == "imul") {
+            writeOperand(line.operands[0]);
+        } else if (op == "push") {
+            registers.insert("rsp");
+            writesMemory = true;
+        } else if (op == "pop") {
+            registers.insert("rsp");
+            writeOperand(line.operands[0]);
+        } else if (op == "cqo") {
+            registers.insert("rdx");
+        } else if (op == "idiv" || op == "div" || op == "mul") {
+            registers.insert("rax");
+            registers.insert("rdx");
+        } else if (op == "leave") {
+            registers.insert("rsp");
+            registers.insert("rbp");
+        } else if (op == "cmp" || op == "test" || op == "nop" || line.isJump()) {
+        } else return false;
+        return true;
+    }
+
+    // Whether a scratch register is possibly read before written, starting from the i-th line
+    static bool isLive(const std::vector<AssemblyLine> &lines, size_t i, const std::string &reg) {
+        for (; i < lines.size(); i++) {
+            auto &line = lines[i];
+            if (line.deleted) continue;
+            if (line.isLabel() || line.isJump() || line.op == "ret" || line.op == "leave") return false;
+            if (line.op == "call") {
+                // builtin$callsysv takes arguments in registers, builtin$checkarrayindex only clobbers rdx
+                if (line.operands[0] == "builtin$callsysv") return true;
+                if (line.operands[0] == "builtin$checkarrayindex") {
+                    if (reg == "rdx") return false;
+                    continue;
+                }
+                // The other functions may take arguments in any registers but the scratch ones
+                return line.operands[0].compare(0, 8, "builtin$") != 0 && !isScratchRegister(reg);
+            }
+
+            // The code generator only reads the low byte written by set*
+            if (line.op.compare(0, 3, "set") == 0 && getRegisterFamily(line.operands[0]) == reg) return false;
+
+            if (isPureWrite(line.op) && line.operands[0] == reg) {
+                return mentions(line.operands[1], reg);
+            }
+            if (line.op == "pop" && line.operands[0] == reg) return false;
+
+            std::set<std::string> registers;
+            bool writesMemory;
+            if (!getEffects(line, registers, writesMemory)) return true;
+            if (mentions(line, reg)) return true;
+            if ((line.op == "cqo" || line.op == "idiv" || line.op == "div" || line.op == "mul") && reg == "rax") return true;
+            if (line.op == "imul" && line.operands.size() == 1 && reg == "rax") return true;
+            if ((line.op == "idiv" || line.op == "div") && reg == "rdx") return true;
+            if (line.op == "cqo" && reg == "rdx") return false;
+        }
+        return false;
+    }
+
+    static size_t next(const std::vector<AssemblyLine> &lines, size_t i) {
+        for (i++; i < lines.size() && lines[i].deleted; i++);
+        return i;
+    }
+
+    static size_t compact(std::vector<AssemblyLine> &lines) {
+        size_t count = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            if (lines[i].deleted) continue;
+            if (i != count) lines[count] = std::move(lines[i]);
+            count++;
+        }
+        size_t removed = lines.size() - count;
+        lines.resize(count);
+        return removed;
+    }
+
+    size_t ruleRemoveNop(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (auto &line : lines) {
+            if (line.op == "nop") line.deleted = true, hits++;
+        }
+        return hits;
+    }
+
+    // add rsp, 0 / sub rsp, 0
+    size_t ruleZeroStackAdjustment(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (auto &line : lines) {
+            if ((line.op == "add" || line.op == "sub") && line.operands[0] == "rsp" && line.operands[1] == "0")
+                line.deleted = true, hits++;
+        }
+        return hits;
+    }
+
+    // mov rsi, rsi
+    size_t ruleSelfMove(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (auto &line : lines) {
+            if ((line.op == "mov" || line.op == "movapd") && line.operands[0] == line.operands[1] && isFullRegister(line.operands[0]))
+                line.deleted = true, hits++;
+        }
+        return hits;
+    }
+
+    // Whether the instructions between the i-th and j-th lines leave a register and the stack alone
+    static bool preserves(const std::vector<AssemblyLine> &lines, size_t i, size_t j, const std::string &reg) {
+        for (i = next(lines, i); i < j; i = next(lines, i)) {
+            auto &line = lines[i];
+            if (line.isLabel() || line.isJump() || line.op == "call" || line.op == "ret") return false;
+
+            std::set<std::string> registers;
+            bool writesMemory;
+            if (!getEffects(line, registers, writesMemory)) return false;
+            if (registers.count(reg) || registers.count("rsp") || mentions(line, "rsp")) return false;
+        }
+        return true;
+    }
+
+    // push X; pop X => (nothing)
+    // push X; pop Y => mov Y, X
+    // push rbx; ...; pop rbx => ... if rbx and the stack are untouched in between
+    size_t rulePushPop(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            if (lines[i].op != "push") continue;
+            size_t j = next(lines, i);
+            while (j < lines.size() && lines[j].op != "pop" && lines[j].op != "push" && !lines[j].isLabel()) j = next(lines, j);
+            if (j == lines.size() || lines[j].op != "pop") continue;
+
+            if (j != next(lines, i)) {
+                auto &reg = lines[i].operands[0];
+                if (lines[j].operands[0] != reg || !isFullRegister(reg) || !preserves(lines, i, j, reg)) continue;
+                lines[i].deleted = lines[j].deleted = true;
+                hits++;
+                continue;
+            }
+
+            auto &from = lines[i].operands[0], &to = lines[j].operands[0];
+            if (from == to) {
+                lines[i].deleted = lines[j].deleted = true;
+            } else if (isMemory(from) && isMemory(to)) {
+                continue;
+            } else if (isDoubleRegisterName(from) || isDoubleRegisterName(to)) {
+                continue;
+            } else {
+                lines[j] = {"", "mov", {to, from}};
+                lines[i].deleted = true;
+            }
+            hits++;
+        }
+        return hits;
+    }
+
+    static bool isDoubleRegisterName(const std::string &operand) {
+        return operand.compare(0, 3, "xmm") == 0;
+    }
+
+    // mov rbx, rbp; mov rbx, qword ptr [rbp + 16] => mov rbx, qword ptr [rbp + 16]
+    size_t ruleOverwrittenMove(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            auto &line = lines[i];
+            if (line.deleted || !isPureWrite(line.op) || !isFullRegister(line.operands[0])) continue;
+
+            size_t j = next(lines, i);
+            if (j == lines.size() || !isPureWrite(lines[j].op) || lines[j].operands[0] != line.operands[0]) continue;
+            if (mentions(lines[j].operands[1], line.operands[0])) continue;
+            line.deleted = true;
+            hits++;
+        }
+        return hits;
+    }
+
+    // mov rax, -2; mov rsi, qword ptr [rbx + rax * 8] => mov rsi, qword ptr [rbx - 16]
+    size_t ruleFoldIndexImmediate(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            auto &line = lines[i];
+            if (line.op != "mov" || !isScratchRegister(line.operands[0]) || !isImmediate(line.operands[1])) continue;
+            auto &reg = line.operands[0];
+            long long displacement = std::strtoll(line.operands[1].c_str(), nullptr, 10) * 8;
+            if (displacement < INT32_MIN || displacement > INT32_MAX) continue;
+
+            size_t j = next(lines, i);
+            if (j == lines.size() || lines[j].isLabel()) continue;
+
+            // Exactly one operand uses the register, as the index, unless it's overwritten by the instruction
+            auto pattern = " + " + reg + " * 8]";
+            bool overwritten = isPureWrite(lines[j].op) && lines[j].operands[0] == reg;
+            size_t count = 0;
+            std::string *target = nullptr;
+            for (size_t k = overwritten ? 1 : 0; k < lines[j].operands.size(); k++) {
+                auto &operand = lines[j].operands[k];
+                if (!mentions(operand, reg)) continue;
+                count++;
+                if (operand.find(pattern) != std::string::npos) target = &operand;
+            }
+            if (count != 1 || !target) continue;
+            if (!overwritten && isLive(lines, next(lines, j), reg)) continue;
+
+            auto pos = target->find(pattern);
+            std::string suffix = displacement == 0 ? "]"
+                               : displacement > 0 ? fmt::format(" + {}]", displacement)
+                                                  : fmt::format(" - {}]", -displacement);
+            target->replace(pos, pattern.size(), suffix);
+            line.deleted = true;
+            hits++;
+        }
+        return hits;
+    }
+
+    // mov qword ptr [r14], rsi; mov rdi, qword ptr [r14] => mov qword ptr [r14], rsi; mov rdi, rsi
+    size_t ruleStoreLoadForwarding(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            auto &store = lines[i];
+            if ((store.op != "mov" && store.op != "movsd") || !isMemory(store.operands[0]) || !isFullRegister(store.operands[1])) continue;
+            if (store.operands[0].compare(0, 9, "qword ptr") != 0) continue;
+
+            size_t j = next(lines, i);
+            if (j == lines.size()) continue;
+            auto &load = lines[j];
+            if ((load.op != "mov" && load.op != "movsd") || load.operands[1] != store.operands[0] || !isFullRegister(load.operands[0])) continue;
+
+            auto &from = store.operands[1], &to = load.operands[0];
+            if (from == to)
+                load.deleted = true;
+            else if (isDoubleRegisterName(from) && isDoubleRegisterName(to))
+                load = {"", "movapd", {to, from}};
+            else if (isDoubleRegisterName(from) || isDoubleRegisterName(to))
+                load = {"", "movq", {to, from}};
+            else
+                load = {"", "mov", {to, from}};
+            hits++;
+        }
+        return hits;
+    }
+
+    // Remove a mov reloading a register with what it already holds within straight-line code
+    size_t ruleRedundantLoad(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        std::map<std::string, std::string> known; // register -> source operand
+        for (auto &line : lines) {
+            if (line.deleted) continue;
+            // Falling through a conditional jump keeps what's known
+            if (line.isLabel() || line.op == "call" || line.op == "ret") {
+                known.clear();
+                continue;
+            }
+
+            if (line.op == "mov" && isFullRegister(line.operands[0]) && !isDoubleRegisterName(line.operands[0])) {
+                auto it = known.find(line.operands[0]);
+                if (it != known.end() && it->second == line.operands[1]) {
+                    line.deleted = true;
+                    hits++;
+                    continue;
+                }
+            }
+
+            std::set<std::string> registers;
+            bool writesMemory;
+            if (!getEffects(line, registers, writesMemory)) {
+                known.clear();
+                continue;
+            }
+            for (auto it = known.begin(); it != known.end(); ) {
+                bool invalid = registers.count(it->first) || (writesMemory && isMemory(it->second));
+                for (auto &reg : registers) invalid = invalid || mentions(it->second, reg);
+                if (invalid) it = known.erase(it);
+                else it++;
+            }
+
+            if (line.op == "mov" && isFullRegister(line.operands[0]) && !isDoubleRegisterName(line.operands[0]) &&
+                !mentions(line.operands[1], line.operands[0]))
+                known[line.operands[0]] = line.operands[1];
+        }
+        return hits;
+    }
+
+    // jmp .L; .L: => .L:
+    size_t ruleJumpToNext(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            if (!lines[i].isJump()) continue;
+            for (size_t j = next(lines, i); j < lines.size() && lines[j].isLabel(); j = next(lines, j)) {
+                if (lines[j].label == lines[i].operands[0]) {
+                    lines[i].deleted = true;
+                    hits++;
+                    break;
+                }
+            }
+        }
+        return hits;
+    }
+
+    // jz .A; jmp .B; .A: => jnz .B; .A:
+    size_t ruleInvertBranch(std::vector<AssemblyLine> &lines) {
+        static const std::map<std::string, std::string> inverses = {
+            {"jz", "jnz"}, {"jnz", "jz"}, {"je", "jne"}, {"jne", "je"},
+            {"jl", "jge"}, {"jge", "jl"}, {"jg", "jle"}, {"jle", "jg"},
+            {"jb", "jae"}, {"jae", "jb"}, {"ja", "jbe"}, {"jbe", "ja"}
+        };
+
+        size_t hits = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            auto it = inverses.find(lines[i].op);
+            if (it == inverses.end()) continue;
+            size_t j = next(lines, i);
+            if (j == lines.size() || !lines[j].isUnconditionalJump()) continue;
+
+            for (size_t k = next(lines, j); k < lines.size() && lines[k].isLabel(); k = next(lines, k)) {
+                if (lines[k].label == lines[i].operands[0]) {
+                    lines[i] = {"", it->second, {lines[j].operands[0]}};
+                    lines[j].deleted = true;
+                    hits++;
+                    break;
+                }
+            }
+        }
+        return hits;
+    }
+
+    // Instructions after jmp or ret up to the next label are never executed
+    size_t ruleUnreachableCode(std::vector<AssemblyLine> &lines) {
+        size_t hits = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            if (!lines[i].isUnconditionalJump() && lines[i].op != "ret") continue;
+            for (size_t j = next(lines, i); j < lines.size() && !lines[j].isLabel(); j = next(lines, j)) {
+                lines[j].deleted = true;
+                hits++;
+            }
+        }
+        return hits;
+    }
+
+    size_t ruleUnusedLabel(std::vector<AssemblyLine> &lines) {
+        std::set<std::string> referenced = entryLabels;
+        for (auto &line : lines) {
+            for (auto &operand : line.operands)
+                for (auto &token : getTokens(operand)) referenced.insert(token);
+        }
+
+        size_t hits = 0;
+        for (auto &line : lines) {
+            if (line.isLabel() && !referenced.count(line.label)) line.deleted = true, hits++;
+        }
+        return hits;
+    }
+
+public:
+    void run(std::list<std::string> &code, const std::set<std::string> &entryLabels) {
+        this->entryLabels = entryLabels;
+
+        std::vector<AssemblyLine> lines;
+        for (auto &line : code) lines.push_back(AssemblyLine::parse(line));
+
+        for (bool changed = true; changed; ) {
+            changed = false;
+            for (auto &rule : rules) {
+                size_t hits = (this->*rule.apply)(lines);
+                compact(lines);
+                rule.hits += hits;
+                changed = changed || hits;
+            }
+        }
+
+        code.clear();
+        for (auto &line : lines) code.push_back(line.toString());
+    }
+
+    void printStatistics(std::ostream &stream) const {
+        for (auto &rule : rules) stream << fmt::format("{:<24}{}", rule.name, rule.hits) << std::endl;
+    }
+};
+
+}
+
+#endif // _MENCI_PEEPHOLE_H
@@ -1,828 +1,550 @@
 .intel_syntax noprefix
-.text
-.TopLevel_79:
-.Constants_1:
-.Constant_16:
-    .quad 1
-.Constant_20:
-    .quad 1
-.Constant_26:
-    .quad 1
-.Constant_30:
-    .quad 1
-.Constant_36:
-    .quad 1
-.Constant_40:
-    .quad 1
-.Constant_44:
-    .quad 1
-.Constant_60:
-    .quad 1
-.Constant_64:
-    .quad 1
-.Constant_76:
+.section .rodata
+.p2align 3
+.Constant_71:
     .byte 32, 0
-.Function_2:
+.bss
+.p2align 3
+.Global_a:
+    .zero 3200
+.Global_b:
+    .zero 3200
+.Global_m:
+    .zero 8
+.Global_n:
+    .zero 8
+.Global_p:
+    .zero 8
+.Global_res:
+    .zero 3200
+.text
+.Function_1:
     push rbp
     mov rbp, rsp
-    sub rsp, 80
-    mov rbx, rbp
-    push rbx
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, 3200
-    mov rbx, rax
-    lea rax, malloc[rip]
-    call builtin$callsysv
-    mov rbx, rax
-    mov qword ptr [r14], rax
-    push 0
-.ArrayInitializeLoop_4:
-    cmp qword ptr [rsp], 400
-    je .ArrayInitializeLoopEnd_3
-    mov rax, qword ptr [rsp]
-    lea r14, qword ptr [rbx + rax * 8]
-    push rbx
-    mov qword ptr [r14], 0
-    pop rbx
-    inc qword ptr [rsp]
-    jmp .ArrayInitializeLoop_4
-.ArrayInitializeLoopEnd_3:
+    sub rsp, 48
+    mov qword ptr [rbp - 32], r12
+    mov qword ptr [rbp - 40], r13
+    mov qword ptr [rbp - 48], r10
+    mov rbx, rbp
+    xor r13, r13
+    xor r10, r10
+    xor r12, r12
+    lea r14, qword ptr .Global_n[rip]
+    push r14
+    call builtin$read
     add rsp, 8
-    pop rbx
-    push rbx
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, 3200
-    mov rbx, rax
-    lea rax, malloc[rip]
-    call builtin$callsysv
-    mov rbx, rax
-    mov qword ptr [r14], rax
-    push 0
-.ArrayInitializeLoop_6:
-    cmp qword ptr [rsp], 400
-    je .ArrayInitializeLoopEnd_5
-    mov rax, qword ptr [rsp]
-    lea r14, qword ptr [rbx + rax * 8]
-    push rbx
-    mov qword ptr [r14], 0
-    pop rbx
-    inc qword ptr [rsp]
-    jmp .ArrayInitializeLoop_6
-.ArrayInitializeLoopEnd_5:
+    lea r14, qword ptr .Global_p[rip]
+    push r14
+    call builtin$read
     add rsp, 8
-    pop rbx
-    push rbx
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -10
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -7
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -5
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -6
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, 3200
-    mov rbx, rax
-    lea rax, malloc[rip]
-    call builtin$callsysv
-    mov rbx, rax
-    mov qword ptr [r14], rax
-    push 0
-.ArrayInitializeLoop_8:
-    cmp qword ptr [rsp], 400
-    je .ArrayInitializeLoopEnd_7
-    mov rax, qword ptr [rsp]
-    lea r14, qword ptr [rbx + rax * 8]
-    push rbx
-    mov qword ptr [r14], 0
-    pop rbx
-    inc qword ptr [rsp]
-    jmp .ArrayInitializeLoop_8
-.ArrayInitializeLoopEnd_7:
+    lea r14, qword ptr .Global_m[rip]
+    push r14
+    call builtin$read
     add rsp, 8
-    pop rbx
-    push rbx
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, 3200
-    mov rbx, rax
-    lea rax, malloc[rip]
-    call builtin$callsysv
-    mov rbx, rax
-    mov qword ptr [r14], rax
-    push 0
-.ArrayInitializeLoop_10:
-    cmp qword ptr [rsp], 400
-    je .ArrayInitializeLoopEnd_9
-    mov rax, qword ptr [rsp]
-    lea r14, qword ptr [rbx + rax * 8]
-    push rbx
-    mov qword ptr [r14], 0
-    pop rbx
-    inc qword ptr [rsp]
-    jmp .ArrayInitializeLoop_10
-.ArrayInitializeLoopEnd_9:
+    mov rsi, 1
+    mov r13, rsi
+    mov rsi, qword ptr .Global_n[rip]
+    push rsi
+.ForLoop_9:
+    cmp r13, qword ptr [rsp]
+    jg .ForLoopExit_8
+    mov rsi, 1
+    mov r10, rsi
+    mov rsi, qword ptr .Global_p[rip]
+    push rsi
+    cmp r13, 1
+    jl .ForLoop_13
+    cmp r13, 20
+    jg .ForLoop_13
+    cmp qword ptr [rsp], 20
+    jg .ForLoop_13
+    mov rsi, r10
+    mov rdi, r13
+    lea r14, qword ptr .Global_a[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov qword ptr [rbp - 8], r14
+.ForLoop_12:
+    cmp r10, qword ptr [rsp]
+    jg .ForLoopExit_11
+    mov r14, qword ptr [rbp - 8]
+    push r14
+    call builtin$read
     add rsp, 8
-    pop rbx
-.Statement_11:
-.Statement_12:
-    mov rbx, rbp
-    mov rax, -5
-    lea r14, qword ptr [rbx + rax * 8]
+    inc r10
+    add qword ptr [rbp - 8], 8
+    jmp .ForLoop_12
+.ForLoop_13:
+    cmp r10, qword ptr [rsp]
+    jg .ForLoopExit_11
+    mov rsi, r10
+    mov rdi, r13
+    lea r14, qword ptr .Global_a[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_16
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_17
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
     push r14
     call builtin$read
     add rsp, 8
-    push r15
+    inc r10
+    jmp .ForLoop_13
+.ForLoopExit_11:
     add rsp, 8
-.Statement_13:
-    mov rbx, rbp
-    mov rax, -6
-    lea r14, qword ptr [rbx + rax * 8]
+    inc r13
+    jmp .ForLoop_9
+.ForLoopExit_8:
+    add rsp, 8
+    mov rsi, 1
+    mov r13, rsi
+    mov rsi, qword ptr .Global_p[rip]
+    push rsi
+.ForLoop_20:
+    cmp r13, qword ptr [rsp]
+    jg .ForLoopExit_19
+    mov rsi, 1
+    mov r10, rsi
+    mov rsi, qword ptr .Global_m[rip]
+    push rsi
+    cmp r13, 1
+    jl .ForLoop_24
+    cmp r13, 20
+    jg .ForLoop_24
+    cmp qword ptr [rsp], 20
+    jg .ForLoop_24
+    mov rsi, r10
+    mov rdi, r13
+    lea r14, qword ptr .Global_b[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov qword ptr [rbp - 8], r14
+.ForLoop_23:
+    cmp r10, qword ptr [rsp]
+    jg .ForLoopExit_22
+    mov r14, qword ptr [rbp - 8]
     push r14
     call builtin$read
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_14:
-    mov rbx, rbp
-    mov rax, -7
-    lea r14, qword ptr [rbx + rax * 8]
+    inc r10
+    add qword ptr [rbp - 8], 8
+    jmp .ForLoop_23
+.ForLoop_24:
+    cmp r10, qword ptr [rsp]
+    jg .ForLoopExit_22
+    mov rsi, r10
+    mov rdi, r13
+    lea r14, qword ptr .Global_b[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_27
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_28
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
     push r14
     call builtin$read
     add rsp, 8
-    push r15
+    inc r10
+    jmp .ForLoop_24
+.ForLoopExit_22:
     add rsp, 8
-.Statement_15:
-    mov rax, .Constant_16[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -5
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_18:
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_17
-.Statement_19:
-    mov rax, .Constant_20[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -6
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_22:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_21
-.Statement_23:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ArrayAccessExpressionArrayEvaluation_24:
-    mov rbx, rbp
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    xor rax, rax
+    inc r13
+    jmp .ForLoop_20
+.ForLoopExit_19:
+    add rsp, 8
+    mov rsi, 1
+    mov r13, rsi
+    mov rsi, qword ptr .Global_n[rip]
+    push rsi
+.ForLoop_31:
+    cmp r13, qword ptr [rsp]
+    jg .ForLoopExit_30
+    mov rsi, 1
+    mov r10, rsi
+    mov rsi, qword ptr .Global_p[rip]
+    push rsi
+.ForLoop_34:
+    cmp r10, qword ptr [rsp]
+    jg .ForLoopExit_33
+    mov rsi, 1
+    mov r12, rsi
+    mov rsi, qword ptr .Global_m[rip]
+    push rsi
+    cmp r13, 1
+    jl .ForLoop_38
+    cmp r13, 20
+    jg .ForLoop_38
+    cmp r10, 1
+    jl .ForLoop_38
+    cmp r10, 20
+    jg .ForLoop_38
+    cmp qword ptr [rsp], 20
+    jg .ForLoop_38
+    mov rsi, r12
+    mov rdi, r13
+    lea r14, qword ptr .Global_res[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov qword ptr [rbp - 8], r14
+    mov rsi, r10
+    lea r14, qword ptr .Global_a[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov qword ptr [rbp - 16], r14
+    mov rsi, r12
+    mov rdi, r10
+    lea r14, qword ptr .Global_b[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov qword ptr [rbp - 24], r14
+.ForLoop_37:
+    cmp r12, qword ptr [rsp]
+    jg .ForLoopExit_36
+    mov r14, qword ptr [rbp - 8]
+    mov rsi, qword ptr [r14]
+    mov r14, qword ptr [rbp - 16]
+    mov rdi, qword ptr [r14]
+    mov r14, qword ptr [rbp - 24]
+    mov r8, qword ptr [r14]
+    imul rdi, r8
+    add rsi, rdi
+    mov r14, qword ptr [rbp - 8]
+    mov qword ptr [r14], rsi
+    inc r12
+    add qword ptr [rbp - 8], 8
+    add qword ptr [rbp - 24], 8
+    jmp .ForLoop_37
+.ForLoop_38:
+    cmp r12, qword ptr [rsp]
+    jg .ForLoopExit_36
+    mov rsi, r12
+    mov rdi, r13
+    lea r14, qword ptr .Global_res[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_47
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_48
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov rsi, qword ptr [r14]
+    mov rdi, r10
+    mov r8, r13
+    lea r14, qword ptr .Global_a[rip]
+    mov rcx, r8
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_51
+    imul rax, rcx, 20
+    mov rcx, rdi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_52
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov rdi, qword ptr [r14]
+    mov r8, r12
+    mov r9, r10
+    lea r14, qword ptr .Global_b[rip]
+    mov rcx, r9
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_53
+    imul rax, rcx, 20
+    mov rcx, r8
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_54
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov r8, qword ptr [r14]
+    imul rdi, r8
+    add rsi, rdi
+    mov rdi, r12
+    mov r8, r13
+    lea r14, qword ptr .Global_res[rip]
+    mov rcx, r8
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_55
+    imul rax, rcx, 20
+    mov rcx, rdi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_56
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov qword ptr [r14], rsi
+    inc r12
+    jmp .ForLoop_38
+.ForLoopExit_36:
+    add rsp, 8
+    inc r10
+    jmp .ForLoop_34
+.ForLoopExit_33:
+    add rsp, 8
+    inc r13
+    jmp .ForLoop_31
+.ForLoopExit_30:
+    add rsp, 8
+    mov rsi, 1
+    mov r13, rsi
+    mov rsi, qword ptr .Global_n[rip]
+    push rsi
+.ForLoop_60:
+    cmp r13, qword ptr [rsp]
+    jg .ForLoopExit_59
+    mov rsi, 1
+    mov r10, rsi
+    mov rsi, qword ptr .Global_m[rip]
+    push rsi
+    cmp r13, 1
+    jl .ForLoop_64
+    cmp r13, 20
+    jg .ForLoop_64
+    cmp qword ptr [rsp], 20
+    jg .ForLoop_64
+    mov rsi, r10
+    mov rdi, r13
+    lea r14, qword ptr .Global_res[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov qword ptr [rbp - 8], r14
+.ForLoop_63:
+    cmp r10, qword ptr [rsp]
+    jg .ForLoopExit_62
+    mov rsi, r10
+    mov rdi, qword ptr .Global_m[rip]
+    cmp rsi, rdi
+    jne .Else_66
+    mov r14, qword ptr [rbp - 8]
+    mov rsi, qword ptr [r14]
+    push rsi
+    call builtin$writeln
+    add rsp, 8
+    jmp .NullStatement_73
+.Else_66:
+    mov r14, qword ptr [rbp - 8]
+    mov rsi, qword ptr [r14]
+    push rsi
+    call builtin$write
+    add rsp, 8
+    lea rsi, .Constant_71[rip]
+    push rsi
+    call builtin$writes
+    add rsp, 8
+.NullStatement_73:
+    inc r10
+    add qword ptr [rbp - 8], 8
+    jmp .ForLoop_63
+.ForLoop_64:
+    cmp r10, qword ptr [rsp]
+    jg .ForLoopExit_62
+    mov rsi, r10
+    mov rdi, qword ptr .Global_m[rip]
+    cmp rsi, rdi
+    jne .Else_75
+    mov rdi, r13
+    lea r14, qword ptr .Global_res[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_77
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_78
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov rsi, qword ptr [r14]
+    push rsi
+    call builtin$writeln
+    add rsp, 8
+    jmp .NullStatement_85
+.Else_75:
+    mov rsi, r10
+    mov rdi, r13
+    lea r14, qword ptr .Global_res[rip]
+    mov rcx, rdi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_81
+    imul rax, rcx, 20
+    mov rcx, rsi
+    sub rcx, 1
+    cmp rcx, 19
+    ja .ArrayIndexOutOfRange_82
+    add rax, rcx
+    lea r14, qword ptr [r14 + rax * 8]
+    mov rsi, qword ptr [r14]
+    push rsi
+    call builtin$write
+    add rsp, 8
+    lea rsi, .Constant_71[rip]
+    push rsi
+    call builtin$writes
+    add rsp, 8
+.NullStatement_85:
+    inc r10
+    jmp .ForLoop_64
+.ForLoopExit_62:
+    add rsp, 8
+    inc r13
+    jmp .ForLoop_60
+.ForLoopExit_59:
+    add rsp, 8
+    mov r12, qword ptr [rbp - 32]
+    mov r13, qword ptr [rbp - 40]
+    mov r10, qword ptr [rbp - 48]
+    leave
+    ret
+.ArrayIndexOutOfRange_16:
+    push rdi
     push 1
     push 20
     push 1
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 20
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
+.ArrayIndexOutOfRange_17:
+    push rsi
     push 1
     push 20
     push 2
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 1
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
-    lea r14, qword ptr [rbx + rax * 8]
-    push r14
-    call builtin$read
-    add rsp, 8
-    push r15
-    add rsp, 8
-    mov rbx, rbp
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_22
-.ForLoopExit_21:
-    add rsp, 8
-    mov rbx, rbp
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_18
-.ForLoopExit_17:
-    add rsp, 8
-.Statement_25:
-    mov rax, .Constant_26[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -6
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_28:
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_27
-.Statement_29:
-    mov rax, .Constant_30[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -7
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_32:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_31
-.Statement_33:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ArrayAccessExpressionArrayEvaluation_34:
-    mov rbx, rbp
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    xor rax, rax
+.ArrayIndexOutOfRange_27:
+    push rdi
     push 1
     push 20
     push 1
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 20
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
+.ArrayIndexOutOfRange_28:
+    push rsi
     push 1
     push 20
     push 2
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 1
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
-    lea r14, qword ptr [rbx + rax * 8]
-    push r14
-    call builtin$read
-    add rsp, 8
-    push r15
-    add rsp, 8
-    mov rbx, rbp
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_32
-.ForLoopExit_31:
-    add rsp, 8
-    mov rbx, rbp
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_28
-.ForLoopExit_27:
-    add rsp, 8
-.Statement_35:
-    mov rax, .Constant_36[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -5
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_38:
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_37
-.Statement_39:
-    mov rax, .Constant_40[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -6
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_42:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_41
-.Statement_43:
-    mov rax, .Constant_44[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -10
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -7
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_46:
-    mov rbx, rbp
-    mov rax, -10
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_45
-.Statement_47:
-.BinaryOperatorLeftOperand_48:
-    mov rbx, rbp
-    mov rax, -10
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ArrayAccessExpressionArrayEvaluation_50:
-    mov rbx, rbp
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    xor rax, rax
+.ArrayIndexOutOfRange_47:
+    push rdi
     push 1
     push 20
     push 1
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 20
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
+.ArrayIndexOutOfRange_48:
+    push rsi
     push 1
     push 20
     push 2
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 1
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
-    lea r14, qword ptr [rbx + rax * 8]
-    push qword ptr [r14]
-.BinaryOperatorRightOperand_49:
-.BinaryOperatorLeftOperand_51:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ArrayAccessExpressionArrayEvaluation_53:
-    mov rbx, rbp
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    xor rax, rax
+.ArrayIndexOutOfRange_51:
+    push r8
     push 1
     push 20
     push 1
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 20
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
+.ArrayIndexOutOfRange_52:
+    push rdi
     push 1
     push 20
     push 2
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 1
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
-    lea r14, qword ptr [rbx + rax * 8]
-    push qword ptr [r14]
-.BinaryOperatorRightOperand_52:
-    mov rbx, rbp
-    mov rax, -10
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ArrayAccessExpressionArrayEvaluation_54:
-    mov rbx, rbp
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    xor rax, rax
+.ArrayIndexOutOfRange_53:
+    push r9
     push 1
     push 20
     push 1
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 20
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
+.ArrayIndexOutOfRange_54:
+    push r8
     push 1
     push 20
     push 2
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 1
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
-    lea r14, qword ptr [rbx + rax * 8]
-    push qword ptr [r14]
-    pop rsi
-    imul rsi, qword ptr [rsp]
-    mov qword ptr [rsp], rsi
-    pop rsi
-    add qword ptr [rsp], rsi
-    mov rbx, rbp
-    mov rax, -10
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ArrayAccessExpressionArrayEvaluation_55:
-    mov rbx, rbp
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    xor rax, rax
+.ArrayIndexOutOfRange_55:
+    push r8
     push 1
     push 20
     push 1
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 20
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
+.ArrayIndexOutOfRange_56:
+    push rdi
     push 1
     push 20
     push 2
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 1
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -10
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_46
-.ForLoopExit_45:
-    add rsp, 8
-    mov rbx, rbp
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_42
-.ForLoopExit_41:
-    add rsp, 8
-    mov rbx, rbp
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_38
-.ForLoopExit_37:
-    add rsp, 8
-.Statement_56:
-    mov rbx, rbp
-    mov rax, -4
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    push 0
-.ArrayAssignLoop_58:
-    cmp qword ptr [rsp], 400
-    je .ArrayAssignLoopEnd_57
-    mov rax, qword ptr [rsp]
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rcx, qword ptr [rsp + 8]
-    mov rax, qword ptr [rcx + rax * 8]
-    push rbx
-    push rax
-    pop qword ptr [r14]
-    pop rbx
-    inc qword ptr [rsp]
-    jmp .ArrayAssignLoop_58
-.ArrayAssignLoopEnd_57:
-    add rsp, 8
-    add rsp, 8
-.Statement_59:
-    mov rax, .Constant_60[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -5
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_62:
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_61
-.Statement_63:
-    mov rax, .Constant_64[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    mov rbx, rbp
-    mov rax, -7
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ForLoop_66:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_65
-.Statement_67:
-.BinaryOperatorLeftOperand_68:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.BinaryOperatorRightOperand_69:
-    mov rbx, rbp
-    mov rax, -7
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    xor rax, rax
-    cmp qword ptr [rsp], rsi
-    sete al
-    mov qword ptr [rsp], rax
-    pop rax
-    test rax, rax
-    jz .Statement_72
-.Statement_70:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ArrayAccessExpressionArrayEvaluation_71:
-    mov rbx, rbp
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    xor rax, rax
+.ArrayIndexOutOfRange_77:
+    push rdi
     push 1
     push 20
     push 1
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 20
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
+.ArrayIndexOutOfRange_78:
+    push rsi
     push 1
     push 20
     push 2
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 1
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
-    lea r14, qword ptr [rbx + rax * 8]
-    push qword ptr [r14]
-    call builtin$writeln
-    add rsp, 8
-    push r15
-    add rsp, 8
-    jmp .NullStatement_78
-.Statement_72:
-.Statement_73:
-    mov rbx, rbp
-    mov rax, -9
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -8
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.ArrayAccessExpressionArrayEvaluation_74:
-    mov rbx, rbp
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rbx, qword ptr [r14]
-    xor rax, rax
+.ArrayIndexOutOfRange_81:
+    push rdi
     push 1
     push 20
     push 1
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 20
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
+.ArrayIndexOutOfRange_82:
+    push rsi
     push 1
     push 20
     push 2
     call builtin$checkarrayindex
-    add rsp, 24
-    mov rdx, 1
-    pop rcx
-    sub rcx, 1
-    imul rdx, rcx
-    add rax, rdx
-    lea r14, qword ptr [rbx + rax * 8]
-    push qword ptr [r14]
-    call builtin$write
-    add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_75:
-    lea rax, .Constant_76[rip]
-    push rax
-    call builtin$writes
-    add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_77:
-    nop
-.NullStatement_78:
-    nop
-    mov rbx, rbp
-    mov rax, -9
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_66
-.ForLoopExit_65:
-    add rsp, 8
-    mov rbx, rbp
-    mov rax, -8
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_62
-.ForLoopExit_61:
-    add rsp, 8
-    mov rbx, rbp
-    push rbx
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, qword ptr [r14]
-    lea rax, free[rip]
-    call builtin$callsysv
-    pop rbx
-    push rbx
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, qword ptr [r14]
-    lea rax, free[rip]
-    call builtin$callsysv
-    pop rbx
-    push rbx
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, qword ptr [r14]
-    lea rax, free[rip]
-    call builtin$callsysv
-    pop rbx
-    push rbx
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, qword ptr [r14]
-    lea rax, free[rip]
-    call builtin$callsysv
-    pop rbx
-    leave
-    ret
 .globl main
 main:
     push rbp
     mov rbp, rsp
-    call .Function_2
+    call .Function_1
     xor rax, rax
     leave
     ret
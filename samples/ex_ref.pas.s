@@ -1,112 +1,59 @@
 .intel_syntax noprefix
+.section .rodata
+.p2align 3
+.bss
+.p2align 3
+.Global_a:
+    .zero 8
 .text
-.TopLevel_19:
-.Constants_1:
-.Constant_6:
-    .quad 123
-.Constant_8:
-    .quad 456
-.Constant_12:
-    .quad 1
-.Constant_14:
-    .quad 2
 .Function_3:
     push rbp
     mov rbp, rsp
-    sub rsp, 0
-    mov rbx, rbp
-.Statement_4:
-.Statement_5:
-    mov rax, .Constant_6[rip]
-    push rax
+    sub rsp, 16
+    mov qword ptr [rbp - 8], rsi
+    mov qword ptr [rbp - 16], rdi
     mov rbx, rbp
-    mov rax, 3
-    lea r14, qword ptr [rbx + rax * 8]
+    mov rsi, 123
+    lea r14, qword ptr [rbx - 8]
     mov r14, qword ptr [r14]
-    pop qword ptr [r14]
-.Statement_7:
-    mov rax, .Constant_8[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, 2
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-.Statement_9:
-    nop
+    mov qword ptr [r14], rsi
+    mov rsi, 456
+    lea r14, qword ptr [rbx - 16]
+    mov qword ptr [r14], rsi
     leave
     ret
-.Function_2:
+.Function_1:
     push rbp
     mov rbp, rsp
-    sub rsp, 16
-    mov rbx, rbp
-    push rbx
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-.Statement_10:
-.Statement_11:
-    mov rax, .Constant_12[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-.Statement_13:
-    mov rax, .Constant_14[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-.Statement_15:
-    mov rbx, rbp
-    push rbx
-    mov rbx, rbp
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    push r14
-    mov rbx, rbp
-    mov rax, -2
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
+    sub rsp, 8
+    mov qword ptr [rbp - 8], r12
+    mov rbx, rbp
+    xor r12, r12
+    mov rsi, 1
+    lea r14, qword ptr .Global_a[rip]
+    mov qword ptr [r14], rsi
+    mov rsi, 2
+    mov r12, rsi
+    lea r14, qword ptr .Global_a[rip]
+    mov rsi, r14
+    mov rdi, 2
     call .Function_3
-    add rsp, 24
-    push r15
-    add rsp, 8
-.Statement_16:
-    mov rbx, rbp
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
+    mov rsi, qword ptr .Global_a[rip]
+    push rsi
     call builtin$writeln
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_17:
-    mov rbx, rbp
-    mov rax, -2
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
+    mov rsi, 2
+    push rsi
     call builtin$writeln
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_18:
-    nop
+    mov r12, qword ptr [rbp - 8]
     leave
     ret
 .globl main
 main:
     push rbp
     mov rbp, rsp
-    call .Function_2
+    call .Function_1
     xor rax, rax
     leave
     ret
@@ -1,193 +1,107 @@
 .intel_syntax noprefix
+.section .rodata
+.p2align 3
+.bss
+.p2align 3
+.Global_a:
+    .zero 8
+.Global_b:
+    .zero 8
 .text
-.TopLevel_22:
-.Constants_1:
-.Constant_8:
-    .quad 0
-.Constant_11:
-    .quad 1
-.Constant_19:
-    .quad 1
-.Function_2:
+.Function_1:
     push rbp
     mov rbp, rsp
-    sub rsp, 32
+    sub rsp, 16
+    mov qword ptr [rbp - 8], r12
+    mov qword ptr [rbp - 16], r13
     mov rbx, rbp
-    push rbx
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, 1
-    lea rax, malloc[rip]
-    call builtin$callsysv
-    mov byte ptr [rax], 0
+    lea r14, qword ptr .Global_a[rip]
+    lea rax, builtin$emptystring[rip]
     mov qword ptr [r14], rax
-    pop rbx
-    push rbx
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, 1
-    lea rax, malloc[rip]
-    call builtin$callsysv
-    mov byte ptr [rax], 0
+    lea r14, qword ptr .Global_b[rip]
+    lea rax, builtin$emptystring[rip]
     mov qword ptr [r14], rax
-    pop rbx
-    push rbx
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-.Statement_3:
-.Statement_4:
-    mov rbx, rbp
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
+    xor r12, r12
+    xor r13, r13
+    lea r14, qword ptr .Global_a[rip]
     push r14
     call builtin$readsln
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_5:
-    mov rbx, rbp
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
+    mov rsi, qword ptr .Global_a[rip]
+    push rsi
     call builtin$strlen
     add rsp, 8
-    push r15
-    mov rbx, rbp
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-.Statement_6:
-    mov rbx, rbp
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov rdi, qword ptr [r14]
-    lea rax, free[rip]
-    call builtin$callsysv
-    mov rdi, qword ptr [rsp]
+    mov rsi, r15
+    mov r13, rsi
+    mov rsi, qword ptr .Global_a[rip]
+    lea r14, qword ptr .Global_b[rip]
+    cmp rsi, qword ptr [r14]
+    je .StringAssignEnd_7
+    push rsi
+    mov rdi, rsi
     lea rax, strlen[rip]
     call builtin$callsysv
-    mov rdi, rax
-    lea rax, malloc[rip]
-    call builtin$callsysv
+    inc rax
+    push rax
+    mov rdi, qword ptr [r14]
+    mov rsi, rax
+    call builtin$resizestring
     mov qword ptr [r14], rax
     mov rdi, rax
+    pop rdx
     pop rsi
-    lea rax, strcpy[rip]
+    lea rax, memcpy[rip]
     call builtin$callsysv
-.Statement_7:
-    mov rax, .Constant_8[rip]
-    push rax
-    mov rbx, rbp
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-.BinaryOperatorLeftOperand_9:
-    mov rbx, rbp
-    mov rax, -3
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.BinaryOperatorRightOperand_10:
-    mov rax, .Constant_11[rip]
-    push rax
-    pop rsi
-    sub qword ptr [rsp], rsi
-.ForLoop_13:
-    mov rbx, rbp
-    mov rax, -4
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    cmp rsi, qword ptr [rsp]
-    jg .ForLoopExit_12
-.Statement_14:
-    mov rbx, rbp
-    mov rax, -2
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -4
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rbx, rbp
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.BinaryOperatorLeftOperand_15:
-.BinaryOperatorLeftOperand_17:
-    mov rbx, rbp
-    mov rax, -3
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.BinaryOperatorRightOperand_18:
-    mov rbx, rbp
-    mov rax, -4
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    sub qword ptr [rsp], rsi
-.BinaryOperatorRightOperand_16:
-    mov rax, .Constant_19[rip]
-    push rax
-    pop rsi
-    sub qword ptr [rsp], rsi
+.StringAssignEnd_7:
+    mov rsi, 0
+    mov r12, rsi
+    mov rsi, r13
+    sub rsi, 1
+    push rsi
+.ForLoop_12:
+    cmp r12, qword ptr [rsp]
+    jg .ForLoopExit_11
+    mov rsi, qword ptr .Global_b[rip]
+    push rsi
+    mov rsi, r12
+    push rsi
+    mov rsi, qword ptr .Global_a[rip]
+    push rsi
+    mov rsi, r13
+    mov rdi, r12
+    sub rsi, rdi
+    sub rsi, 1
+    push rsi
     call builtin$getchr
     add rsp, 16
-    push r15
+    mov rsi, r15
+    push rsi
     call builtin$setchr
     add rsp, 24
-    push r15
-    add rsp, 8
-    mov rbx, rbp
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    inc qword ptr [r14]
-    jmp .ForLoop_13
-.ForLoopExit_12:
+    inc r12
+    jmp .ForLoop_12
+.ForLoopExit_11:
     add rsp, 8
-.Statement_20:
-    mov rbx, rbp
-    mov rax, -2
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
+    mov rsi, qword ptr .Global_b[rip]
+    push rsi
     call builtin$writesln
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_21:
-    nop
     mov rbx, rbp
-    push rbx
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
+    lea r14, qword ptr .Global_a[rip]
     mov rdi, qword ptr [r14]
-    lea rax, free[rip]
-    call builtin$callsysv
-    pop rbx
-    push rbx
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
+    call builtin$freestring
+    lea r14, qword ptr .Global_b[rip]
     mov rdi, qword ptr [r14]
-    lea rax, free[rip]
-    call builtin$callsysv
-    pop rbx
+    call builtin$freestring
+    mov r12, qword ptr [rbp - 8]
+    mov r13, qword ptr [rbp - 16]
     leave
     ret
 .globl main
 main:
     push rbp
     mov rbp, rsp
-    call .Function_2
+    call .Function_1
     xor rax, rax
     leave
     ret
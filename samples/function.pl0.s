@@ -1,177 +1,58 @@
 .intel_syntax noprefix
+.section .rodata
+.p2align 3
+.bss
+.p2align 3
+.Global_x:
+    .zero 8
+.Global_y:
+    .zero 8
 .text
-.TopLevel_34:
-.Constants_1:
-.Constant_7:
-    .quad 1
-.Constant_12:
-    .quad 10
-.Constant_18:
-    .quad 2
-.Constant_19:
-    .quad 1
-.Constant_25:
-    .quad 3
-.Constant_26:
-    .quad 11
 .Function_3:
-    push rbp
-    mov rbp, rsp
-    sub rsp, 0
-    mov rbx, rbp
-.Statement_4:
-.BinaryOperatorLeftOperand_5:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.BinaryOperatorRightOperand_6:
-    mov rax, .Constant_7[rip]
-    push rax
-    pop rsi
-    xor rax, rax
-    cmp qword ptr [rsp], rsi
-    setl al
-    mov qword ptr [rsp], rax
-    pop rax
-    test rax, rax
-    jz .Statement_9
-.Statement_8:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    jmp .NullStatement_28
-.Statement_9:
-.BinaryOperatorLeftOperand_10:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.BinaryOperatorRightOperand_11:
-    mov rax, .Constant_12[rip]
-    push rax
-    pop rsi
-    xor rax, rax
-    cmp qword ptr [rsp], rsi
-    setl al
-    mov qword ptr [rsp], rax
-    pop rax
-    test rax, rax
-    jz .Statement_20
-.Statement_13:
-.BinaryOperatorLeftOperand_14:
-.BinaryOperatorLeftOperand_16:
-    mov rax, .Constant_18[rip]
-    push rax
-.BinaryOperatorRightOperand_17:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    imul rsi, qword ptr [rsp]
-    mov qword ptr [rsp], rsi
-.BinaryOperatorRightOperand_15:
-    mov rax, .Constant_19[rip]
-    push rax
-    pop rsi
-    sub qword ptr [rsp], rsi
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    jmp .NullStatement_27
-.Statement_20:
-.BinaryOperatorLeftOperand_21:
-.BinaryOperatorLeftOperand_23:
-    mov rax, .Constant_25[rip]
-    push rax
-.BinaryOperatorRightOperand_24:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    imul rsi, qword ptr [rsp]
-    mov qword ptr [rsp], rsi
-.BinaryOperatorRightOperand_22:
-    mov rax, .Constant_26[rip]
-    push rax
-    pop rsi
-    sub qword ptr [rsp], rsi
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-.NullStatement_27:
-    nop
-.NullStatement_28:
-    nop
-    leave
+    mov rsi, qword ptr .Global_x[rip]
+    cmp rsi, 1
+    jge .Else_6
+    lea r14, qword ptr .Global_y[rip]
+    mov qword ptr [r14], rsi
+    jmp .NullStatement_21
+.Else_6:
+    mov rsi, qword ptr .Global_x[rip]
+    cmp rsi, 10
+    jge .Else_9
+    add rsi, rsi
+    sub rsi, 1
+    lea r14, qword ptr .Global_y[rip]
+    mov qword ptr [r14], rsi
+    jmp .NullStatement_20
+.Else_9:
+    mov rsi, qword ptr .Global_x[rip]
+    lea rsi, qword ptr [rsi + rsi * 2]
+    sub rsi, 11
+    lea r14, qword ptr .Global_y[rip]
+    mov qword ptr [r14], rsi
+.NullStatement_20:
+.NullStatement_21:
     ret
-.Function_2:
+.Function_1:
     push rbp
     mov rbp, rsp
-    sub rsp, 16
-    mov rbx, rbp
-    push rbx
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-.Statement_29:
-.Statement_30:
     mov rbx, rbp
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
+    lea r14, qword ptr .Global_x[rip]
     push r14
     call builtin$read
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_31:
-    mov rbx, rbp
-    push rbx
     call .Function_3
-    add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_32:
-    mov rbx, rbp
-    mov rax, -2
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
+    mov rsi, qword ptr .Global_y[rip]
+    push rsi
     call builtin$writeln
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_33:
-    nop
     leave
     ret
 .globl main
 main:
     push rbp
     mov rbp, rsp
-    call .Function_2
+    call .Function_1
     xor rax, rax
     leave
     ret
@@ -1,188 +1,67 @@
 .intel_syntax noprefix
+.section .rodata
+.p2align 3
+.bss
+.p2align 3
+.Global_a:
+    .zero 8
+.Global_b:
+    .zero 8
+.Global_c:
+    .zero 8
+.Global_max:
+    .zero 8
 .text
-.TopLevel_23:
-.Constants_1:
 .Function_3:
-    push rbp
-    mov rbp, rsp
-    sub rsp, 0
-    mov rbx, rbp
-.Statement_4:
-.Statement_5:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
+    lea r14, qword ptr .Global_a[rip]
     push r14
     call builtin$read
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_6:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
+    lea r14, qword ptr .Global_b[rip]
     push r14
     call builtin$read
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_7:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
+    lea r14, qword ptr .Global_c[rip]
     push r14
     call builtin$read
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_8:
-.BinaryOperatorLeftOperand_9:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.BinaryOperatorRightOperand_10:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -2
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    xor rax, rax
-    cmp qword ptr [rsp], rsi
-    setg al
-    mov qword ptr [rsp], rax
-    pop rax
-    test rax, rax
-    jz .Statement_12
-.Statement_11:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -1
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
+    mov rsi, qword ptr .Global_a[rip]
+    mov rdi, qword ptr .Global_b[rip]
+    cmp rsi, rdi
+    jle .Else_10
+    lea r14, qword ptr .Global_max[rip]
+    mov qword ptr [r14], rsi
     jmp .NullStatement_13
-.Statement_12:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -2
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
+.Else_10:
+    mov rsi, qword ptr .Global_b[rip]
+    lea r14, qword ptr .Global_max[rip]
+    mov qword ptr [r14], rsi
 .NullStatement_13:
-    nop
-.Statement_14:
-.BinaryOperatorLeftOperand_15:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -4
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-.BinaryOperatorRightOperand_16:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -3
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    pop rsi
-    xor rax, rax
-    cmp qword ptr [rsp], rsi
-    setg al
-    mov qword ptr [rsp], rax
-    pop rax
-    test rax, rax
-    jz .Statement_18
-.Statement_17:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -4
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-    jmp .NullStatement_19
-.Statement_18:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -3
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    pop qword ptr [r14]
-.NullStatement_19:
-    nop
-.Statement_20:
-    mov rax, 2
-    mov rbx, qword ptr [rbp + rax * 8]
-    mov rax, -4
-    mov rax, qword ptr [rbx + rax * 8]
-    push rax
+    mov rsi, qword ptr .Global_max[rip]
+    mov rdi, qword ptr .Global_c[rip]
+    cmp rsi, rdi
+    jg .NullStatement_18
+    mov rsi, qword ptr .Global_c[rip]
+    lea r14, qword ptr .Global_max[rip]
+    mov qword ptr [r14], rsi
+.NullStatement_18:
+    mov rsi, qword ptr .Global_max[rip]
+    push rsi
     call builtin$writeln
     add rsp, 8
-    push r15
-    add rsp, 8
-.Statement_21:
-    nop
-    leave
     ret
-.Function_2:
+.Function_1:
     push rbp
     mov rbp, rsp
-    sub rsp, 32
     mov rbx, rbp
-    push rbx
-    mov rax, -1
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -2
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -3
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-    push rbx
-    mov rax, -4
-    lea r14, qword ptr [rbx + rax * 8]
-    mov qword ptr [r14], 0
-    pop rbx
-.Statement_22:
-    mov rbx, rbp
-    push rbx
     call .Function_3
-    add rsp, 8
-    push r15
-    add rsp, 8
     leave
     ret
 .globl main
 main:
     push rbp
     mov rbp, rsp
-    call .Function_2
+    call .Function_1
     xor rax, rax
     leave
     ret
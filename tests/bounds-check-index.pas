@@ -0,0 +1,16 @@
+var m: array [0..3, -2..2] of integer;
+    c: integer;
+
+procedure put(r, c, v: integer);
+begin
+  m[r, c] := v;
+  writeln(m[r, c])
+end;
+
+begin
+  put(3, 0 - 2, 5);
+  put(0, 2, 7);
+  c := 3;
+  put(1, c, 9);
+  writeln(m[1, 0])
+end.
@@ -0,0 +1,31 @@
+var a: array [1..10] of integer;
+    m: array [0..3, -2..2] of integer;
+    s: integer;
+
+procedure fill(n: integer);
+var i: integer;
+begin
+  for i := 1 to n do begin
+    a[i] := i * i;
+    writeln(a[i])
+  end
+end;
+
+procedure column(c, n: integer);
+var r: integer;
+begin
+  s := 0;
+  for r := n downto 0 do begin
+    m[r, c] := r + c;
+    s := s + m[r, c]
+  end;
+  writeln(s)
+end;
+
+begin
+  fill(3);
+  column(2, 3);
+  column(0 - 2, 2);
+  fill(12);
+  writeln(0 - 1)
+end.
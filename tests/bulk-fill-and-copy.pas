@@ -0,0 +1,40 @@
+type vec = array [1..12] of integer;
+     pair = record v: vec; tag: integer; end;
+var g, h: pair;
+    i: integer;
+
+procedure dirty;
+var junk: vec;
+    j: integer;
+begin
+  for j := 1 to 12 do junk[j] := 7;
+  g.v := junk
+end;
+
+function weigh(at, by: integer; scale: double): integer;
+var v, w: vec;
+    j, t: integer;
+begin
+  t := 0;
+  for j := 1 to 12 do t := t + v[j];
+  v[at] := by;
+  w := v;
+  for j := 1 to 12 do t := t + w[j] * j;
+  weigh := t + at;
+  if scale > 1.5 then weigh := t + at + 100
+end;
+
+begin
+  dirty;
+  writeln(weigh(3, 5, 1.0));
+  dirty;
+  writeln(weigh(12, 0 - 2, 2.0));
+  g.tag := 9;
+  h := g;
+  g.v[1] := 0;
+  writeln(h.v[1] + h.v[12] + h.tag);
+  writeln(g.v[1]);
+  for i := 1 to 12 do h.v[i] := i;
+  g := h;
+  writeln(g.v[7] + g.tag)
+end.
@@ -0,0 +1,42 @@
+type arr = array [1..12] of integer;
+var g: integer;
+    ga: arr;
+
+procedure q(var r: integer; n: integer);
+var x, y: integer;
+begin
+  x := r * 3 + n;
+  g := 7;
+  y := r * 3 + n;
+  writeln(x);
+  writeln(y)
+end;
+
+procedure e(var r0: integer);
+begin
+  writeln(r0 * 5 + 1);
+  ga[(r0 mod 12 + 12) mod 12 + 1] := 1;
+  writeln(r0 * 5 + 1);
+  writeln(r0)
+end;
+
+procedure s(var a: arr; var r: integer);
+var i, t: integer;
+begin
+  t := 0;
+  for i := 1 to 3 do begin
+    t := t + r * 2 + i;
+    a[i] := t
+  end;
+  writeln(t)
+end;
+
+begin
+  g := 1;
+  q(g, 2);
+  ga[1] := 0;
+  e(ga[1]);
+  ga[1] := 5;
+  s(ga, ga[1]);
+  writeln(ga[3])
+end.
@@ -0,0 +1,8 @@
+procedure never;
+begin
+  undefinedvar := nosuchfunction(3, 4)
+end;
+
+begin
+  writeln(1)
+end.
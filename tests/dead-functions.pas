@@ -0,0 +1,45 @@
+var n, total: integer;
+
+function square(v: integer): integer;
+begin
+  square := v * v
+end;
+
+function unused(v: integer): integer;
+begin
+  writesln('never printed');
+  unused := v + 1
+end;
+
+procedure dead;
+var s: string;
+
+  procedure deeper;
+  begin
+    writef(3.25)
+  end;
+
+begin
+  reads(s);
+  writes(s);
+  call deeper;
+  writeln(unused(2))
+end;
+
+function parity(v: integer): integer;
+begin
+  if v < 2 then parity := v else parity := parity(v - 2)
+end;
+
+function onlyinline(v: integer): integer;
+begin
+  onlyinline := v + 100
+end;
+
+begin
+  n := 7;
+  total := square(n) + square(n + 1);
+  writeln(total);
+  writeln(parity(n));
+  writeln(onlyinline(n))
+end.
@@ -0,0 +1,32 @@
+var xs: array [1..9] of integer;
+    i, x: integer;
+
+begin
+  xs[1] := 0; xs[2] := 1; xs[3] := 0 - 1; xs[4] := 7; xs[5] := 0 - 7;
+  xs[6] := 12345678901; xs[7] := 0 - 98765432123;
+  xs[8] := (1 shl 63) - 1; xs[9] := 1 shl 63;
+  for i := 1 to 9 do begin
+    x := xs[i];
+    writeln(x);
+    writeln(x * 3);
+    writeln(x * (0 - 10));
+    writeln(x div 2);
+    writeln(x mod 2);
+    writeln(x div 8);
+    writeln(x mod 8);
+    writeln(x div 7);
+    writeln(x mod 7);
+    writeln(x div 641);
+    writeln(x mod 641);
+    writeln(x div (0 - 2));
+    writeln(x mod (0 - 2));
+    writeln(x div (0 - 8));
+    writeln(x mod (0 - 8));
+    writeln(x div (0 - 7));
+    writeln(x mod (0 - 7));
+    writeln(x div (0 - 2147483648));
+    writeln(x mod (0 - 2147483648));
+    writeln(x div (1 shl 63));
+    writeln(x mod (1 shl 63))
+  end
+end.
@@ -0,0 +1,49 @@
+type
+  pt = record x, y: integer; end;
+  mat = array [0..5, 1..6] of integer;
+var
+  g: mat;
+  ps: array [1..10] of pt;
+  i, j, n, s: integer;
+  d: array [-3..3] of double;
+  e: double;
+
+procedure fill(var m: mat; base: integer);
+var r, c: integer;
+begin
+  for r := 0 to 5 do
+    for c := 1 to 6 do
+      m[r, c] := base + r * 10 + c
+end;
+
+function diagonal(var m: mat): integer;
+var t, q: integer;
+begin
+  t := 0;
+  for q := 0 to 5 do t := t + m[q, q + 1];
+  diagonal := t
+end;
+
+begin
+  fill(g, 0);
+  writeln(diagonal(g));
+  s := 0;
+  for j := 6 downto 1 do s := s + g[2, j] * j - g[5, 7 - j];
+  writeln(s);
+  for i := 1 to 10 do begin
+    ps[i].x := i;
+    ps[i].y := i * i
+  end;
+  s := 0;
+  for i := 10 downto 2 do s := s + ps[i].y - ps[i - 1].x;
+  writeln(s);
+  n := 0;
+  s := 0;
+  for i := 1 to n do s := s + ps[i].x;
+  writeln(s);
+  writeln(i);
+  for i := 0 - 3 to 3 do d[i] := i * 1.5;
+  e := 0.0;
+  for i := 3 downto 0 - 3 do e := e + d[i] * d[0 - i];
+  writeln(e)
+end.
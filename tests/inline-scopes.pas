@@ -0,0 +1,43 @@
+var x, base: integer;
+
+function addb(v: integer): integer;
+begin
+  addb := v + base
+end;
+
+function mulx(v: integer): integer;
+begin
+  mulx := v * x
+end;
+
+procedure p;
+var base: integer;
+
+  function shifted(v: integer): integer;
+  begin
+    shifted := v - base
+  end;
+
+  procedure q(x: integer);
+  var base: integer;
+  begin
+    base := 1000;
+    writeln(addb(x));
+    writeln(mulx(x));
+    writeln(shifted(x));
+    writeln(addb(mulx(base)) + shifted(base))
+  end;
+
+begin
+  base := 50;
+  q(7);
+  base := 0 - 50;
+  q(8)
+end;
+
+begin
+  x := 3;
+  base := 20;
+  p;
+  writeln(addb(x) + mulx(base))
+end.
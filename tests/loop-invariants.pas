@@ -0,0 +1,57 @@
+type arr = array [1..10] of integer;
+var a: arr;
+    g, i, s: integer;
+
+procedure bump;
+begin
+  g := g + 1
+end;
+
+function withref(var v: integer; n: integer): integer;
+var r, j: integer;
+begin
+  r := 0;
+  for j := 1 to n do begin
+    r := r + v * 3 + 1;
+    a[j] := j * 10
+  end;
+  withref := r
+end;
+
+function globalref(var v: integer; n: integer): integer;
+var r, j: integer;
+begin
+  r := 0;
+  j := 0;
+  while j < n do begin
+    r := r + v * 2;
+    g := g + 5;
+    j := j + 1
+  end;
+  globalref := r
+end;
+
+function guarded(n, d: integer): integer;
+var r, j: integer;
+begin
+  r := 0;
+  for j := 1 to n do r := r + 100 div d;
+  guarded := r
+end;
+
+begin
+  for i := 1 to 10 do a[i] := i;
+  writeln(withref(a[3], 5));
+  g := 1;
+  writeln(globalref(g, 3));
+  writeln(g);
+  writeln(guarded(0, 0));
+  writeln(guarded(4, 7));
+  g := 0;
+  s := 0;
+  for i := 1 to 4 do begin
+    s := s + g * 10;
+    bump
+  end;
+  writeln(s)
+end.
@@ -0,0 +1,52 @@
+type
+  person = record name: string; age: integer; end;
+  people = array [1..3] of person;
+var
+  s, t: string;
+  ps, qs: people;
+  p: person;
+  k: integer;
+
+procedure strings;
+var a, b, c: string; k: integer;
+begin
+  a := 'first';
+  b := a;
+  writesln(b);
+  k := 0;
+  while k < 3 do begin
+    a := 'loop';
+    strcat(a, b, c);
+    b := c;
+    k := k + 1
+  end;
+  writesln(b);
+  writesln(c);
+  a := 'x';
+  b := a;
+  a := 'y';
+  writesln(a);
+  writesln(b)
+end;
+
+begin
+  s := 'hello';
+  t := s;
+  s := 'world';
+  writesln(t);
+  writesln(s);
+  strings;
+  for k := 1 to 3 do begin
+    ps[k].name := 'p';
+    ps[k].age := k
+  end;
+  qs := ps;
+  ps[2].name := 'changed';
+  ps[3].age := 30;
+  writesln(qs[2].name);
+  writeln(qs[3].age);
+  p := qs[1];
+  qs[1].age := 10;
+  writeln(p.age);
+  writesln(ps[2].name)
+end.
@@ -0,0 +1,39 @@
+var d, e, one: double;
+    n: integer;
+
+procedure show(b: integer);
+begin
+  write(b)
+end;
+
+begin
+  d := 0.0;
+  e := d / d;
+  one := 1.0;
+  writeln(e > 1.0);
+  writeln(e >= 1.0);
+  writeln(e < 1.0);
+  writeln(e <= 1.0);
+  writeln(e = e);
+  writeln(e <> e);
+  writeln(one < e);
+  writeln(one >= e);
+
+  n := 0;
+  if e > 1.0 then n := n + 1;
+  if e >= one then n := n + 2;
+  if e < 1.0 then n := n + 4;
+  if e <= one then n := n + 8;
+  if e = e then n := n + 16;
+  if e <> e then n := n + 32;
+  if !(e < one) then n := n + 64;
+  writeln(n);
+
+  n := 0;
+  while e < one do n := n + 1;
+  repeat n := n + 10 until !(e >= 1.0);
+  writeln(n);
+  show((e > one) and then (e < one));
+  show((e <> e) or else (e > one));
+  writeln(0)
+end.
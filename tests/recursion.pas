@@ -0,0 +1,41 @@
+var i: integer;
+
+function fib(n: integer): integer;
+begin
+  if n < 2 then fib := n
+  else fib := fib(n - 1) + fib(n - 2)
+end;
+
+function ackermann(m, n: integer): integer;
+begin
+  if m = 0 then ackermann := n + 1
+  else if n = 0 then ackermann := ackermann(m - 1, 1)
+  else ackermann := ackermann(m - 1, ackermann(m, n - 1))
+end;
+
+function iseven(n: integer): integer;
+  function isodd(k: integer): integer;
+  begin
+    if k = 0 then isodd := 0 else isodd := iseven(k - 1)
+  end;
+begin
+  if n = 0 then iseven := 1 else iseven := isodd(n - 1)
+end;
+
+procedure hanoi(n, from, onto, via: integer; var moves: integer);
+begin
+  if n > 0 then begin
+    hanoi(n - 1, from, via, onto, moves);
+    moves := moves + 1;
+    hanoi(n - 1, via, onto, from, moves)
+  end
+end;
+
+begin
+  writeln(fib(20));
+  writeln(ackermann(2, 3));
+  for i := 0 to 5 do writeln(iseven(i));
+  i := 0;
+  hanoi(10, 1, 3, 2, i);
+  writeln(i)
+end.
@@ -0,0 +1,25 @@
+var x: integer;
+
+function f: integer;
+begin
+  f := 7
+end;
+
+procedure show;
+begin
+  writeln(f + 1)
+end;
+
+function f: double;
+begin
+  f := 2.5
+end;
+
+begin
+  show;
+  x := 3;
+  if f > x then writeln(1) else writeln(0);
+  x := 2;
+  if f > x then writeln(1) else writeln(0);
+  writef(f + 1)
+end.
@@ -0,0 +1,66 @@
+var c: array [1..16] of integer;
+    n, i, k: integer;
+
+function lowbit(v: integer): integer;
+begin
+  lowbit := v and (0 - v)
+end;
+
+procedure update(i, v: integer);
+begin
+  while i <= n do begin
+    c[i] := c[i] + v;
+    i := i + lowbit(i)
+  end
+end;
+
+function query(i: integer): integer;
+var r: integer;
+begin
+  r := 0;
+  while i > 0 do begin
+    r := r + c[i];
+    i := i - lowbit(i)
+  end;
+  query := r
+end;
+
+function mix(a: integer; b: double; var c: integer; d: integer; e: double): double;
+begin
+  c := c + a * d;
+  mix := b * e + a - d
+end;
+
+function rot(a, b, c, d, k: integer): integer;
+begin
+  if k = 0 then rot := a * 1000 + b * 100 + c * 10 + d
+  else rot := rot(b, c, d, a, k - 1)
+end;
+
+function six(a, b, c, d, e, f: integer): integer;
+begin
+  six := a - b + c - d + e - f
+end;
+
+function outer(a, b: integer): integer;
+  function inner(x: integer): integer;
+  begin
+    inner := x * a + b
+  end;
+begin
+  outer := inner(a) + inner(b)
+end;
+
+begin
+  n := 16;
+  for i := 1 to n do update(i, i);
+  writeln(query(16));
+  writeln(query(7) - query(3));
+  k := 5;
+  writeln(mix(3, 1.5, k, 4, 2.0));
+  writeln(k);
+  writeln(rot(1, 2, 3, 4, 3));
+  writeln(six(60, 50, 40, 30, 20, 10));
+  writeln(six(rot(1, 2, 3, 4, 1), 1, 2, 3, 4, 5));
+  writeln(outer(3, 4))
+end.
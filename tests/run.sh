@@ -0,0 +1,71 @@
+#!/bin/sh
+# Compile and run a regression program, comparing its output with the .out file next to it and its
+# exit status with the .status file, or 0
+# A program without an .out file must be rejected by the compiler, which is checked the same way
+# Each line of an optional .flags file is another set of compiler flags to check the program with
+# usage: run.sh <compiler> <program.pas> [compiler flags...]
+compiler=$1
+program=$2
+shift 2
+
+base=${program%.pas}
+work=$(mktemp -d) || exit 1
+trap 'rm -rf "$work"' EXIT
+trap 'exit 1' INT TERM
+
+compare() {
+    # A program expected to fail has its messages in the .err file and its exit status in the .status file
+    if [ -f "$base.err" ]; then
+        diff -u "$base.err" "$work/errors" || return 1
+    elif [ -s "$work/errors" ]; then
+        cat "$work/errors"
+        return 1
+    fi
+    expected=0
+    [ -f "$base.status" ] && expected=$(cat "$base.status")
+    if [ "$status" != "$expected" ]; then
+        echo "exit status $status, expected $expected"
+        return 1
+    fi
+}
+
+check() {
+    if [ ! -f "$base.out" ]; then
+        "$compiler" "$@" "$program" > "$work/program.s" 2> "$work/errors"
+        status=$?
+        if [ "$status" = 0 ]; then
+            echo "compiled, expected to be rejected"
+            return 1
+        fi
+        compare
+        return
+    fi
+
+    "$compiler" "$@" "$program" > "$work/program.s" || return 1
+    gcc -no-pie -Wl,--gc-sections -o "$work/program" "$work/program.s" "$(dirname "$0")/../builtin-functions.s" || return 1
+
+    # The symbols in an optional .absent file must have been left out of the program
+    if [ -f "$base.absent" ]; then
+        nm "$work/program" | awk '{ print $NF }' > "$work/symbols" || return 1
+        while read -r symbol; do
+            if grep -Fqx "$symbol" "$work/symbols"; then
+                echo "$symbol is linked in"
+                return 1
+            fi
+        done < "$base.absent"
+    fi
+
+    input=/dev/null
+    [ -f "$base.in" ] && input=$base.in
+    "$work/program" < "$input" > "$work/output" 2> "$work/errors"
+    status=$?
+    diff -u "$base.out" "$work/output" || return 1
+    compare
+}
+
+check "$@" || exit 1
+if [ -f "$base.flags" ]; then
+    while read -r flags; do
+        check "$@" $flags || exit 1
+    done < "$base.flags"
+fi
@@ -0,0 +1,49 @@
+var a: array [1..5] of integer;
+    i, n, calls: integer;
+
+function f(v: integer): integer;
+begin
+  calls := calls + 1;
+  f := v
+end;
+
+function search(w: integer): integer;
+var i: integer;
+begin
+  i := 1;
+  while (i <= n) and then (a[i] <> w) do i := i + 1;
+  search := i
+end;
+
+function guarded(d: integer): integer;
+begin
+  if (d <> 0) and then (100 div d > 10) then guarded := 100 div d
+  else guarded := 0 - 1
+end;
+
+begin
+  n := 5;
+  for i := 1 to 5 do a[i] := i * i;
+  writeln(search(9));
+  writeln(search(7));
+  writeln(guarded(0));
+  writeln(guarded(4));
+  writeln(guarded(20));
+
+  calls := 0;
+  if (f(0) > 0) and then (f(1) > 0) then writeln(1) else writeln(0);
+  writeln(calls);
+  calls := 0;
+  if (f(1) > 0) or else (f(0) > 0) then writeln(1) else writeln(0);
+  writeln(calls);
+  calls := 0;
+  if ((f(0) > 0) or else (f(2) > 1)) and then (f(3) <> 3) then writeln(1) else writeln(0);
+  writeln(calls);
+  calls := 0;
+  if (f(1) > 0) and (f(0) > 0) then writeln(1) else writeln(0);
+  writeln(calls);
+  calls := 0;
+  i := 0;
+  repeat i := i + 1 until (i >= 3) or else (f(i) = 10);
+  writeln(calls)
+end.
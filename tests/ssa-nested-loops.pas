@@ -0,0 +1,27 @@
+var i, c1, c2, s: integer;
+begin
+  i := 0;
+  while i < 5 do begin
+    c1 := 0;
+    repeat
+      c2 := 0;
+      while c2 < 2 do c2 := c2 + 1;
+      c1 := c1 + 1
+    until c1 >= 2;
+    i := i + 1;
+    writeln(i)
+  end;
+
+  s := 0;
+  for i := 1 to 12 do begin
+    c1 := 0;
+    repeat
+      c2 := 0;
+      while c2 < 2 do c2 := c2 + 1;
+      c1 := c1 + 1
+    until c1 >= 2;
+    s := s + c1 + c2
+  end;
+  writeln(i);
+  writeln(s)
+end.
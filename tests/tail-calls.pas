@@ -0,0 +1,56 @@
+type arr = array [1..4] of integer;
+var total: integer;
+    a: arr;
+
+function gcd(a, b: integer): integer;
+begin
+  if b = 0 then gcd := a
+  else gcd := gcd(b, a mod b)
+end;
+
+function sumto(n, acc: integer): integer;
+begin
+  if n = 0 then sumto := acc
+  else sumto := sumto(n - 1, acc + n)
+end;
+
+procedure countdown(n: integer);
+begin
+  if n > 0 then begin
+    total := total + n;
+    countdown(n - 1)
+  end
+end;
+
+procedure swapdown(var p: arr; i, j: integer);
+var t: integer;
+begin
+  if i < j then begin
+    t := p[i];
+    p[i] := p[j];
+    p[j] := t;
+    swapdown(p, i + 1, j - 1)
+  end
+end;
+
+function parity(n, acc: integer): integer;
+  function step(k: integer): integer;
+  begin
+    step := k - 2
+  end;
+begin
+  if n < 2 then parity := acc + n
+  else parity := parity(step(n), acc)
+end;
+
+begin
+  writeln(gcd(1071, 462));
+  writeln(gcd(17, 0));
+  writeln(sumto(100000, 0));
+  countdown(100000);
+  writeln(total);
+  a[1] := 1; a[2] := 2; a[3] := 3; a[4] := 4;
+  swapdown(a, 1, 4);
+  writeln(a[1] * 1000 + a[2] * 100 + a[3] * 10 + a[4]);
+  writeln(parity(100001, 0))
+end.
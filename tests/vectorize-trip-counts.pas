@@ -0,0 +1,36 @@
+type arr = array [1..12] of integer;
+     darr = array [1..12] of double;
+var a, b, c: arr;
+    x, y, z: darr;
+    i, n, s: integer;
+    d: double;
+
+begin
+  for i := 1 to 12 do begin
+    a[i] := i * 3 - 20;
+    b[i] := 100 - i * i;
+    x[i] := i * 0.5;
+    y[i] := 3.0 - i
+  end;
+  for n := 0 to 9 do begin
+    for i := 1 to 12 do c[i] := 0 - 1;
+    for i := 1 to n do c[i] := a[i] + b[i] * 2;
+    s := 0;
+    for i := 1 to 12 do s := s + c[i] * i;
+    writeln(s);
+
+    s := 0;
+    for i := 1 to n do s := s + (a[i] xor b[i]);
+    writeln(s);
+
+    for i := 1 to 12 do z[i] := 0.25;
+    for i := 1 to n do z[i] := x[i] * y[i] + 1.5;
+    d := 0.0;
+    for i := 1 to 12 do d := d + z[i] * i;
+    writeln(d);
+
+    d := 0.0;
+    for i := 1 to n do d := d + x[i] - y[i];
+    writeln(d)
+  end
+end.